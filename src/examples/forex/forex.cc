@@ -12,8 +12,6 @@
 #include "kernel/vita.h"
 #include "trade_simulator.h"
 
-enum timeframe : unsigned {short_tf = 0, medium_tf, long_tf, sup_tf};
-
 namespace fxs  // Forex symbols
 {
 using team = vita::team<vita::i_mep>;
@@ -31,48 +29,66 @@ enum
 ///            one and so on (a greater value identifies an older candle).
 ///            It's called shift in Metatrader
 ///
+/// \note Requires a `fx_interpreter` to work.
+///
 template<timeframe TF, unsigned I>
 class tfi_terminal : public vita::terminal
 {
 public:
-  tfi_terminal(const std::string &n, vita::category_t c)
+  // The current bar (`I == 0`) isn't completed: its values aren't known at
+  // decision time.
+  static_assert(I > 0);
+
+  tfi_terminal(const std::string &n, feature f, vita::category_t c)
     : vita::terminal(n + "("
                      + std::to_string(TF) + "," + std::to_string(I) +
-                     ")", c)
+                     ")", c), f_(f)
   {
   }
 
   bool input() const override { return true; }
-  vita::value_t eval(vita::core_interpreter *) const override { return {}; }
+
+  /// \return the value of the feature for the current bar
+  vita::value_t eval(vita::core_interpreter *i) const override
+  {
+    const auto v(static_cast<fx_interpreter *>(i)->fetch(TF, f_, I));
+
+    if (category() == c_logic)
+      return static_cast<vita::D_INT>(v);
+    return v;
+  }
 
   std::string display(terminal::param_t, format) const override
   {
     return name();
   }
+
+private:
+  feature f_;
 };
 
 template<timeframe TF, unsigned I>
 struct close : tfi_terminal<TF, I>
 {
-  close() : tfi_terminal<TF, I>("close", c_money) {}
+  close() : tfi_terminal<TF, I>("close", f_close, c_money) {}
 };
 
 template<timeframe TF, unsigned I>
 struct high : tfi_terminal<TF, I>
 {
-  high() : tfi_terminal<TF, I>("high", c_money) {}
+  high() : tfi_terminal<TF, I>("high", f_high, c_money) {}
 };
 
 template<timeframe TF, unsigned I>
 struct low : tfi_terminal<TF, I>
 {
-  low() : tfi_terminal<TF, I>("low", c_money) {}
+  low() : tfi_terminal<TF, I>("low", f_low, c_money) {}
 };
 
 template<timeframe TF, unsigned I>
 struct open : tfi_terminal<TF, I>
 {
-  open() : tfi_terminal<TF, I>("open", c_money) {}
+  open() : tfi_terminal<TF, I>("open", f_open, c_money) {}
 };
 
 /// Black candle is formed when the opening price is higher than the closing
@@ -80,7 +96,8 @@ struct open : tfi_terminal<TF, I>
 template<timeframe TF, unsigned I>
 struct black_candle : tfi_terminal<TF, I>
 {
-  black_candle() : tfi_terminal<TF, I>("black_candle", c_logic) {}
+  black_candle()
+    : tfi_terminal<TF, I>("black_candle", f_black_candle, c_logic) {}
 };
 
 /// White candle is formed when the opening price is lower than the closing
@@ -88,7 +105,8 @@ struct black_candle : tfi_terminal<TF, I>
 template<timeframe TF, unsigned I>
 struct white_candle : tfi_terminal<TF, I>
 {
-  white_candle() : tfi_terminal<TF, I>("white_candle", c_logic) {}
+  white_candle()
+    : tfi_terminal<TF, I>("white_candle", f_white_candle, c_logic) {}
 };
 
 /// Doji are important candlesticks that provide information on their own and
@@ -101,7 +119,7 @@ struct white_candle : tfi_terminal<TF, I>
 template<timeframe TF, unsigned I>
 struct doji : tfi_terminal<TF, I>
 {
-  doji() : tfi_terminal<TF, I>("doji", c_logic) {}
+  doji() : tfi_terminal<TF, I>("doji", f_doji, c_logic) {}
 };
 
 /// Bearish Harami (meaning "pregnant" in Japanese) consists of an unusually
@@ -111,7 +129,8 @@ struct doji : tfi_terminal<TF, I>
 template<timeframe TF>
 struct bearish_harami : tfi_terminal<TF, 1>
 {
-  bearish_harami() : tfi_terminal<TF, 1>("bearish_harami", c_logic) {}
+  bearish_harami()
+    : tfi_terminal<TF, 1>("bearish_harami", f_bearish_harami, c_logic) {}
 };
 
 /// Bullish Harami (meaning "pregnant" in Japanese) consists of an unusually
@@ -121,7 +140,8 @@ struct bearish_harami : tfi_terminal<TF, 1>
 template<timeframe TF>
 struct bullish_harami : tfi_terminal<TF, 1>
 {
-  bullish_harami() : tfi_terminal<TF, 1>("bullish_harami", c_logic) {}
+  bullish_harami()
+    : tfi_terminal<TF, 1>("bullish_harami", f_bullish_harami, c_logic) {}
 };
 
 /// Dark Cloud Cover consists of a long white candlestick followed by a black
@@ -131,25 +151,28 @@ struct bullish_harami : tfi_terminal<TF, 1>
 template<timeframe TF>
 struct dark_cloud_cover : tfi_terminal<TF, 1>
 {
-  dark_cloud_cover() : tfi_terminal<TF, 1>("dark_cloud_cover", c_logic) {}
+  dark_cloud_cover()
+    : tfi_terminal<TF, 1>("dark_cloud_cover", f_dark_cloud_cover, c_logic) {}
 };
 
 template<timeframe TF, unsigned I>
 struct long_candle : tfi_terminal<TF, I>
 {
-  long_candle() : tfi_terminal<TF, I>("long_candle", c_logic) {}
+  long_candle() : tfi_terminal<TF, I>("long_candle", f_long_candle, c_logic) {}
 };
 
 template<timeframe TF, unsigned I>
 struct long_black_candle : tfi_terminal<TF, I>
 {
-  long_black_candle() : tfi_terminal<TF, I>("long_black_candle", c_logic) {}
+  long_black_candle()
+    : tfi_terminal<TF, I>("long_black_candle", f_long_black_candle, c_logic) {}
 };
 
 template<timeframe TF, unsigned I>
 struct long_white_candle : tfi_terminal<TF, I>
 {
-  long_white_candle() : tfi_terminal<TF, I>("long_white_candle", c_logic) {}
+  long_white_candle()
+    : tfi_terminal<TF, I>("long_white_candle", f_long_white_candle, c_logic) {}
 };
 
 struct l_and : vita::boolean::l_and
@@ -180,7 +203,7 @@ struct lt_m : vita::real::lt
 class evaluator : public vita::evaluator<team>
 {
 public:
-  explicit evaluator(trade_simulator *ts) : ts_(ts) {}
+  explicit evaluator(const trade_simulator *ts) : ts_(ts) {}
 
   vita::fitness_t operator()(const team &t) final
   {
@@ -188,7 +211,7 @@ public:
   }
 
 private:
-  trade_simulator *ts_;
+  const trade_simulator *ts_;
 };
 
 class search : public vita::search<team, vita::alps_es>
@@ -268,10 +291,6 @@ int main()
   p.env.layers = 6;
   p.env.team.individuals = 2;  // DO NOT CHANGE
   p.env.alps.age_gap = 10;
-  p.env.cache_size = 20;       // A hash table of `2^20` elements.
-                               // Considering the speed of the Metatrader
-                               // back-tester this should ensure a very low
-                               // hash collision rate.
 
   p.env.stat.dynamic_file    = "dynamic.txt";
   p.env.stat.layers_file     = "layers.txt";
@@ -1,7 +1,7 @@
 /*
  *  \remark This file is part of VITA.
  *
- *  \copyright Copyright (C) 2017-2018 EOS di Manlio Morini.
+ *  \copyright Copyright (C) 2017-2020 EOS di Manlio Morini.
  *
  *  \license
  *  This Source Code Form is subject to the terms of the Mozilla Public
@@ -9,61 +9,29 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
-#include <chrono>
-#include <cstdio>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 
-// MinGW compiled with the win32 threading model (a common choice) at the
-// moment doesn't support C++11 threading classes (see
-// <https://github.com/StephanTLavavej/mingw-distro/issues/26> and
-// <https://github.com/meganz/mingw-std-threads>)
-#if defined(__MINGW32__)
-#include <windows.h>
-inline void sleep_for(std::chrono::milliseconds x)
-{ Sleep(x.count()); }
-#else
-#include <thread>
-inline void sleep_for(std::chrono::milliseconds x)
-{ std::this_thread::sleep_for(x); }
-#endif
-
 #include "trade_simulator.h"
+#include "utility/csv_parser.h"
 #include "utility/utility.h"
 #include "tinyxml2/tinyxml2.h"
 
 namespace
 {
 
-struct trade_results
-{
-  trade_results(const std::string &filepath)
-  {
-    std::ifstream results(filepath);
-    while (!results.is_open())
-    {
-      sleep_for(std::chrono::milliseconds(500));
-      results.open(filepath);
-    }
-
-    if (!(results >> profit))
-      throw std::runtime_error("Cannot read profit from " + filepath);
-
-    if (!(results >> short_trades))
-      throw std::runtime_error("Cannot read number of short trades from "
-                               + filepath);
-
-    if (!(results >> long_trades))
-      throw std::runtime_error("Cannot read numer of long trades from "
-                               + filepath);
+// Bars of the base timeframe required before the first decision (as in the
+// Expert Advisor template).
+constexpr std::size_t min_bars = 60;
 
-    if (!(results >> drawdown))
-      throw std::runtime_error("Cannot read balance drawdown from "
-                               + filepath);
-
-    results.close();
-  }
+// Bars of every timeframe available to the patterns (`CopyRates` window of
+// the Expert Advisor template).
+constexpr std::size_t window_size = 16;
 
+struct trade_results
+{
   double profit       = 0.0;
   double short_trades = 0.0;
   double long_trades  = 0.0;
@@ -72,15 +40,6 @@ struct trade_results
   double trades() const { return short_trades + long_trades; }
 };
 
-// Always output Windows EOL (`\r\n`).
-// This is useful for ini files of Windows programs.
-std::ostream &wendl(std::ostream &o)
-{
-  o.put('\r');
-  o.put('\n');
-  return o;
-}
-
 double fitness(const trade_results &r, int days)
 {
   // Losing EAs don't require a complex evaluation.
@@ -109,6 +68,30 @@ double fitness(const trade_results &r, int days)
   return trades_ratio_weight * displacement_weight * recovery_factor;
 }
 
+// Converts a Metatrader timeframe identifier (`M15`, `H1`, `D1`...) to
+// minutes.
+unsigned minutes(const std::string &tf)
+{
+  const auto n(tf.size() > 1 ? std::atoi(tf.c_str() + 1) : 0);
+
+  if (n > 0)
+    switch (tf.front())
+    {
+    case 'M':  return n;
+    case 'H':  return 60 * n;
+    case 'D':  return 24 * 60 * n;
+    }
+
+  throw std::runtime_error("Unknown timeframe: " + tf);
+}
+
+// Value of a pattern for the current bar (`true` if the pattern is present).
+bool signal(fx_interpreter &intr, std::size_t bar)
+{
+  const auto v(intr.run(bar));
+  return std::holds_alternative<vita::D_INT>(v) && std::get<vita::D_INT>(v);
+}
+
 }  // unnamed namespace
 
 
@@ -120,11 +103,12 @@ std::string trade_simulator::full_path(const std::string &fn) const
 ///
 /// Inits the object.
 ///
-/// Reads the configuration from `forex.xml` file.
+/// Reads the configuration from `forex.xml` file and the historical data
+/// from the CSV file it refers to.
 ///
 trade_simulator::trade_simulator()
 {
-  const std::string ini(full_path("forex.xml"));
+  const std::string ini("forex.xml");
 
   tinyxml2::XMLDocument doc;
   if (doc.LoadFile(ini.c_str()) != tinyxml2::XML_SUCCESS)
@@ -142,33 +126,19 @@ trade_simulator::trade_simulator()
              ? he.ToElement()->GetText() : def;
   };
 
-  auto read_file = [this](const std::string name)
+  const auto number_or = [&](const char name[], const char def[])
   {
-    std::ifstream from(full_path(name));
-    if (!from)
-      throw std::runtime_error("Error opening " + name);
-
-    std::stringstream buffer;
-    buffer << from.rdbuf();
-    return buffer.str();
+    return std::stod(value_or(tester.FirstChildElement(name), def));
   };
 
-  // --- Various filenames ---
-  ea_name_      = value_or(files.FirstChildElement("name"), "gpea.mq5");
-  ini_name_     = value_or(files.FirstChildElement("ini"), "gpea.ini");
-  results_name_ = value_or(files.FirstChildElement("results"), "results.txt");
   working_dir_  = value_or(files.FirstChildElement("workingdir"), "./");
 
-  // --- Content of buffered files ---
-  ea_template_ = read_file(value_or(files.FirstChildElement("template"),
-                                    "template.mq5"));
-
   // --- Testing parameters ---
-  symbol_         = value_or(tester.FirstChildElement("symbol"), "EURUSD");
-  period_         = value_or(tester.FirstChildElement("period"), "M15");
-  deposit_        = value_or(tester.FirstChildElement("deposit"), "10000");
-  model_          = value_or(tester.FirstChildElement("model"), "1");
-  execution_mode_ = value_or(tester.FirstChildElement("execution_mode"), "65");
+  contract_size_ = number_or("contract_size", "100000");
+  deposit_       = number_or("deposit", "10000");
+  lot_           = number_or("lot", "0.1");
+  point_         = number_or("point", "0.00001");
+  spread_        = number_or("spread", "10") * point_;
 
   std::istringstream from_date(value_or(tester.FirstChildElement("from_date"),
                                         "2016-01-01"));
@@ -190,72 +160,177 @@ trade_simulator::trade_simulator()
 
   Ensures(validation_set_.empty() == forward_date.str().empty());
   Ensures(!training_set_.empty());
+
+  // --- Historical data ---
+  const auto base(
+    minutes(value_or(tester.FirstChildElement("period"), "M15")));
+  const auto medium(
+    minutes(value_or(tester.FirstChildElement("medium_timeframe"), "H1")));
+  const auto longer(
+    minutes(value_or(tester.FirstChildElement("long_timeframe"), "H4")));
+
+  if (base >= medium || medium >= longer)
+    throw std::runtime_error("Timeframes must be in increasing order");
+
+  load_data(value_or(files.FirstChildElement("data"), "ohlc.csv"),
+            medium, longer);
+  compute_features();
 }
 
-// Writes the ini file used by Metatrader to setup the back-test.
-void trade_simulator::write_ini_file(const period &p) const
+// Reads the bars of the base timeframe (`time,open,high,low,close` records,
+// oldest first, time in the `YYYY-MM-DD hh:mm` format) and aggregates them
+// into the other timeframes.
+void trade_simulator::load_data(const std::string &name, unsigned medium,
+                                unsigned longer)
 {
-  // Get the expert name removing the extension from EA filename.
-  std::string expert(ea_name_);
-  auto last_dot(expert.find_last_of("."));
-  if (last_dot != std::string::npos)
-    expert = expert.substr(0, last_dot);
-
-  // See <https://www.metatrader5.com/en/terminal/help/start_advanced/start>
-  std::ofstream o(full_path(ini_name_));
-  if (!o)
-    throw std::runtime_error("Error creating ini file: " + ini_name_);
-
-  o << "[Tester]"                          << wendl
-    << "Expert="        << expert          << wendl
-    << "Symbol="        << symbol_         << wendl
-    << "Period="        << period_         << wendl
-    << "Deposit="       << deposit_        << wendl
-    << "Model="         << model_          << wendl
-    << "Optimization=0"                    << wendl
-    << "ExecutionMode=" << execution_mode_ << wendl;
-
-  o << "FromDate=";
-  date::to_stream(o, "%Y.%m.%d", p.start);
-  o << wendl;
-
-  o << "ToDate=";
-  date::to_stream(o, "%Y.%m.%d", p.end);
-  o << wendl;
-
-  o << "ReplaceReport=1" << wendl
-    << "ShutdownTerminal=1" << wendl
-    << "Visual=0" << wendl;
-
-  o.close();
+  std::ifstream from(full_path(name));
+  if (!from)
+    throw std::runtime_error("Error opening data file: " + name);
+
+  auto &base(bars_[short_tf]);
+  for (auto record : vita::csv_parser(from).trim_ws(true))
+  {
+    if (record.size() < 5)
+      continue;
+
+    candle c;
+    std::istringstream time(record[0]);
+    if (!(time >> date::parse("%F %R", c.time)))
+    {
+      if (base.empty())
+        continue;  // header
+      throw std::runtime_error("Wrong time format: " + record[0]);
+    }
+
+    c.open  = std::stod(record[1]);
+    c.high  = std::stod(record[2]);
+    c.low   = std::stod(record[3]);
+    c.close = std::stod(record[4]);
+
+    if (!base.empty() && c.time <= base.back().time)
+      throw std::runtime_error("Bars must be sorted by time");
+
+    base.push_back(c);
+  }
+
+  if (base.size() < min_bars)
+    throw std::runtime_error("Too few bars in " + name);
+
+  for (std::size_t i(0); i < base.size(); ++i)
+    current_[short_tf].push_back(i);
+
+  for (const auto &[tf, length] : {std::pair(medium_tf, medium),
+                                   std::pair(long_tf, longer)})
+    for (const auto &b : base)
+    {
+      const auto start(b.time - b.time.time_since_epoch()
+                                % std::chrono::minutes(length));
+
+      if (bars_[tf].empty() || bars_[tf].back().time != start)
+        bars_[tf].push_back({start, b.open, b.high, b.low, b.close});
+      else
+      {
+        auto &last(bars_[tf].back());
+        last.high  = std::max(last.high, b.high);
+        last.low   = std::min(last.low, b.low);
+        last.close = b.close;
+      }
+
+      current_[tf].push_back(bars_[tf].size() - 1);
+    }
 }
 
-void trade_simulator::write_ea_file(const vita::team<vita::i_mep> &prg) const
+// Precomputes the values of the features for every bar of every timeframe.
+// The definitions of the candlestick patterns are the same of the Expert
+// Advisor template.
+void trade_simulator::compute_features()
 {
-  std::stringstream ss[2];
+  for (unsigned tf(short_tf); tf < sup_tf; ++tf)
+  {
+    const auto &b(bars_[tf]);
+    const auto n(b.size());
+
+    const auto body([&](std::size_t i)
+                    { return std::fabs(b[i].open - b[i].close); });
+    const auto black([&](std::size_t i) { return b[i].close < b[i].open; });
+    const auto white([&](std::size_t i) { return b[i].close > b[i].open; });
+
+    // A long candle has a real body three times longer than the average
+    // body of the previous five candles (but not too long).
+    const auto long_candle([&](std::size_t i)
+    {
+      if (i < 5)
+        return false;
+
+      double avg_body(0.0);
+      for (unsigned j(1); j <= 5; ++j)
+        avg_body += (body(i - j) - avg_body) / j;
 
-  ss[0] << vita::out::mql_language << prg[0];
-  ss[1] << vita::out::mql_language << prg[1];
+      return 3.0 * avg_body < body(i) && body(i) < 6.0 * avg_body;
+    });
 
-  auto ea(ea_template_);
+    auto &f(features_[tf]);
+    for (auto &column : f)
+      column.assign(n, 0.0);
 
-  ea = vita::replace(ea,
-                     "bool buy_pattern() {return false;}",
-                     "bool buy_pattern() {return " + ss[0].str() + ";}");
+    for (std::size_t i(0); i < n; ++i)
+    {
+      f[f_open][i]  = b[i].open;
+      f[f_high][i]  = b[i].high;
+      f[f_low][i]   = b[i].low;
+      f[f_close][i] = b[i].close;
+
+      f[f_black_candle][i] = black(i);
+      f[f_white_candle][i] = white(i);
+
+      f[f_long_candle][i] = long_candle(i);
+      f[f_long_black_candle][i] = black(i) && long_candle(i);
+      f[f_long_white_candle][i] = white(i) && long_candle(i);
+
+      const double shadow(b[i].high - b[i].low);
+      f[f_doji][i] = shadow > 0.0 && body(i) / shadow < 0.025;
+
+      if (i > 0)
+      {
+        const auto &prev(b[i - 1]);
+
+        f[f_bearish_harami][i] = white(i - 1) && long_candle(i - 1)
+                                 && black(i)
+                                 && b[i].close > prev.open
+                                 && b[i].open < prev.close;
+
+        f[f_bullish_harami][i] = black(i - 1) && long_candle(i - 1)
+                                 && white(i)
+                                 && b[i].close < prev.open
+                                 && b[i].open > prev.close;
+
+        f[f_dark_cloud_cover][i] = white(i - 1) && black(i)
+                                   && b[i].close > prev.open
+                                   && b[i].open >= prev.high;
+      }
+    }
+  }
+}
 
-  ea = vita::replace(ea,
-                     "bool sell_pattern() {return false;}",
-                     "bool sell_pattern() {return " + ss[1].str() + ";}");
+///
+/// \param[in] tf    a timeframe
+/// \param[in] f     a feature
+/// \param[in] shift `1` is the last completed bar of timeframe `tf`, `2` the
+///                  previous one and so on
+/// \param[in] bar   index of the current bar of the base timeframe
+/// \return          the value of feature `f`
+///
+double trade_simulator::fetch(timeframe tf, feature f, unsigned shift,
+                              std::size_t bar) const
+{
+  Expects(tf < sup_tf);
+  Expects(f < sup_feature);
+  Expects(0 < shift && shift < window_size);
 
-  const auto fo(full_path(ea_name_));
-  const auto fo_tmp(fo + ".tmp");
-  std::ofstream o(fo_tmp);
-  if (!o)
-    throw std::runtime_error("Error creating EA file: " + fo);
-  o << ea;
-  o.close();
+  const auto i(current_[tf][bar]);
+  Expects(shift <= i);
 
-  std::rename(fo_tmp.c_str(), fo.c_str());
+  return features_[tf][f][i - shift];
 }
 
 date::days period::size() const
@@ -263,22 +338,158 @@ date::days period::size() const
   return date::sys_days(end) - date::sys_days(start);
 }
 
-vita::fitness_t trade_simulator::run(const vita::team<vita::i_mep> &prg)
+///
+/// Back-tests a trading strategy on the training set.
+///
+/// \param[in] prg a team of two patterns (buy / sell)
+/// \return        fitness, profit, balance drawdown and number of trades
+///
+/// \remark
+/// Orders are executed at the opening price of the bar (plus the spread for
+/// buy orders). Stop loss / take profit levels are checked against the
+/// high / low of the bars; when both are reached within the same bar, the
+/// stop loss is assumed to come first.
+///
+vita::fitness_t trade_simulator::run(const vita::team<vita::i_mep> &prg) const
 {
-  write_ini_file(training_set_);
-  write_ea_file(prg);
+  Expects(prg.individuals() == 2);
+
+  fx_interpreter buy_pattern(&prg[0], this), sell_pattern(&prg[1], this);
+
+  const auto start(date::sys_days(training_set_.start));
+  const auto end(date::sys_days(training_set_.end));
+  const auto &bars(bars_[short_tf]);
+
+  struct
+  {
+    int sgn = 0;  // `+1` long, `-1` short, `0` no position
+    double price, sl, tp;
+  } pos;
+
+  trade_results r;
+  double balance(deposit_), peak(deposit_);
+
+  // `price` is the bid price for long positions, the ask price for short
+  // ones.
+  const auto close_position([&](double price)
+  {
+    const double profit(pos.sgn * (price - pos.price) * lot_
+                        * contract_size_);
+
+    r.profit += profit;
+    balance += profit;
+    peak = std::max(peak, balance);
+    r.drawdown = std::max(r.drawdown, peak - balance);
+
+    if (pos.sgn > 0)
+      ++r.long_trades;
+    else
+      ++r.short_trades;
+
+    pos.sgn = 0;
+  });
+
+  std::size_t last(0);
+  for (std::size_t b(min_bars); b < bars.size(); ++b)
+  {
+    const auto &bar(bars[b]);
+    if (bar.time < start)
+      continue;
+    if (bar.time >= end)
+      break;
+    if (current_[long_tf][b] < window_size)
+      continue;  // not enough history
+    last = b;
+
+    const double bid(bar.open), ask(bar.open + spread_);
+
+    bool buy_condition(false), sell_condition(false);
+    if (pos.sgn > 0)
+      sell_condition = signal(sell_pattern, b);
+    else if (pos.sgn < 0)
+      buy_condition = signal(buy_pattern, b);
+    else
+    {
+      buy_condition = signal(buy_pattern, b);
+      if (!buy_condition)
+        sell_condition = signal(sell_pattern, b);
+    }
+
+    if (buy_condition != sell_condition)
+    {
+      const int sgn(buy_condition ? +1 : -1);
+
+      if (pos.sgn)  // the opposite order closes the position (netting)
+        close_position(sgn > 0 ? ask : bid);
+      else
+      {
+        double lowest(bars[b - 1].low), highest(bars[b - 1].high);
+        for (unsigned i(2); i <= 5; ++i)
+        {
+          highest = std::max(highest, bars[b - i].high);
+          lowest  = std::min(lowest, bars[b - i].low);
+        }
+        const double delta(std::max(highest - lowest, 100.0 * point_));
+
+        const double ref(sgn > 0 ? ask : bid);
+        pos.sgn = sgn;
+        pos.price = ref;
+        pos.sl = ref - sgn * delta;
+        pos.tp = ref + sgn * delta;
+      }
+    }
+
+    if (pos.sgn > 0)
+    {
+      if (bar.low <= pos.sl)
+        close_position(std::min(pos.sl, bid));
+      else if (bar.high >= pos.tp)
+        close_position(std::max(pos.tp, bid));
+    }
+    else if (pos.sgn < 0)
+    {
+      if (bar.high + spread_ >= pos.sl)
+        close_position(std::max(pos.sl, ask));
+      else if (bar.low + spread_ <= pos.tp)
+        close_position(std::min(pos.tp, ask));
+    }
+  }
 
-  const auto results_path(full_path(results_name_));
-  trade_results r(results_path);
-  std::remove(results_path.c_str());
+  if (pos.sgn)  // open positions are closed at the end of the test
+    close_position(bars[last].close + (pos.sgn < 0 ? spread_ : 0.0));
 
-  double fit(fitness(r, training_set_.size().count()));
+  const double fit(fitness(r, training_set_.size().count()));
 
   using vita::log;
-  vitaINFO << "CURRENT EA. Profit:" << r.profit
-           << " Drawdown:" << r.drawdown
-           << " Trades:" << r.trades()
-           << " Fit:" << fit;
+  vitaDEBUG << "CURRENT EA. Profit:" << r.profit
+            << " Drawdown:" << r.drawdown
+            << " Trades:" << r.trades()
+            << " Fit:" << fit;
 
   return {fit, r.profit, r.drawdown, r.trades()};
 }
+
+///
+/// Calculates the value of a pattern at the opening of a bar.
+///
+/// \param[in] bar index of a bar of the base timeframe
+/// \return        the output value of the pattern
+///
+vita::value_t fx_interpreter::run(std::size_t bar)
+{
+  bar_ = bar;
+  return run();
+}
+
+///
+/// Used by the `tfi_terminal`s to retrieve the value of a feature.
+///
+/// \param[in] tf    a timeframe
+/// \param[in] f     a feature
+/// \param[in] shift `1` is the last completed bar, `2` the previous one...
+/// \return          the value of the feature for the current bar
+///
+double fx_interpreter::fetch(timeframe tf, feature f, unsigned shift) const
+{
+  return ts_->fetch(tf, f, shift, bar_);
+}
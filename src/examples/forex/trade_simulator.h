@@ -17,6 +17,23 @@
 #include "kernel/vita.h"
 #include "third_party/date/date.h"
 
+enum timeframe : unsigned {short_tf = 0, medium_tf, long_tf, sup_tf};
+
+///
+/// Per-bar values available to the trading patterns.
+///
+enum feature : unsigned
+{
+  f_open = 0, f_high, f_low, f_close,
+
+  f_black_candle, f_white_candle,
+  f_long_candle, f_long_black_candle, f_long_white_candle,
+  f_doji,
+  f_bearish_harami, f_bullish_harami, f_dark_cloud_cover,
+
+  sup_feature
+};
+
 ///
 /// A temporal interval.
 ///
@@ -35,34 +52,85 @@ struct period
 };
 
 ///
-/// Interface to Metatrader5 software.
+/// Back-tester of trading strategies over historical OHLC data.
+///
+/// Bars of the base timeframe are read from a CSV file and aggregated into
+/// the medium / long timeframes. The values of every feature (prices,
+/// candlestick patterns) are precomputed for every bar of every timeframe,
+/// so the evaluation of a strategy only requires table lookups.
+///
+/// The simulation follows the logic of the Expert Advisor template
+/// (`template.mq5`): a decision is taken at the opening of every bar, a
+/// position is closed by the opposite pattern or when it hits the stop loss /
+/// take profit levels.
 ///
 class trade_simulator
 {
 public:
   trade_simulator();
 
-  vita::fitness_t run(const vita::team<vita::i_mep> &);
+  vita::fitness_t run(const vita::team<vita::i_mep> &) const;
+
+  double fetch(timeframe, feature, unsigned, std::size_t) const;
 
 private:
+  struct candle
+  {
+    date::sys_time<std::chrono::minutes> time;
+    double open;
+    double high;
+    double low;
+    double close;
+  };
+
+  void load_data(const std::string &, unsigned, unsigned);
+  void compute_features();
   std::string full_path(const std::string &) const;
-  void write_ea_file(const vita::team<vita::i_mep> &) const;
-  void write_ini_file(const period &) const;
 
-  std::string      ea_name_;
-  std::string  ea_template_;
-  std::string     ini_name_;
-  std::string results_name_;
-  std::string  working_dir_;
+  std::string working_dir_;
+
+  double contract_size_;
+  double deposit_;
+  double lot_;
+  double point_;
+  double spread_;
+
+  // `bars_[tf]` contains the bars of timeframe `tf` (oldest first).
+  std::vector<candle> bars_[sup_tf];
 
-  std::string        deposit_;
-  std::string execution_mode_;
-  std::string          model_;
-  std::string         period_;
-  std::string         symbol_;
+  // `current_[tf][b]` is the index of the bar of timeframe `tf` containing
+  // the `b`-th bar of the base timeframe.
+  std::vector<std::size_t> current_[sup_tf];
+
+  // `features_[tf][f][i]` is the value of feature `f` for the `i`-th bar of
+  // timeframe `tf`.
+  std::vector<double> features_[sup_tf][sup_feature];
 
   period   training_set_;
   period validation_set_;
 };
 
+///
+/// Interpreter for the trading patterns.
+///
+/// Feeds the `tfi_terminal`s with the values of the current bar.
+///
+class fx_interpreter : public vita::interpreter<vita::i_mep>
+{
+public:
+  fx_interpreter(const vita::i_mep *prg, const trade_simulator *ts)
+    : vita::interpreter<vita::i_mep>(prg), ts_(ts), bar_(0)
+  {}
+
+  vita::value_t run(std::size_t);
+
+  double fetch(timeframe, feature, unsigned) const;
+
+private:
+  using vita::interpreter<vita::i_mep>::run;
+
+  const trade_simulator *ts_;
+  std::size_t bar_;
+};
+
 #endif  // include guard
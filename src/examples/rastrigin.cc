@@ -13,7 +13,7 @@
 
 #include "kernel/vita.h"
 
-double neg_rastrigin(const std::vector<double> &x)
+double neg_rastrigin(vita::span<const double> x)
 {
   constexpr double  A = 10.0;
   constexpr double PI =  3.141592653589793;
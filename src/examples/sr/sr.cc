@@ -34,6 +34,7 @@ Copyright 2011-2018 EOS di Manlio Morini (https://eosdev.it/)
 
 Usage:
   sr [options] DATASET
+  sr [options] --hub=<address>
   sr -h | --help
   sr -v | --version
 
@@ -70,6 +71,10 @@ Options:
   --threshold=<val>      success threshold for a run
   --arl                  enables Adaptive Representation through Learning
   --cache=<bits>         cache will contain `2^bits` elements
+  --migration=<address>  joins the island model coordinated by the hub at
+                         `address` (`unix:PATH` or `HOST:PORT`)
+  --hub=<address>        runs the hub of an island model made of many `sr`
+                         processes
   --random-seed=<seed>   sets the seed for the pseudo-random number generator
                          (equences are repeatable by using the same seed value)
   --stat-dir=DIR         base path for log files
@@ -384,6 +389,24 @@ void go(bool = true)
   s.run(runs);
 }
 
+// Runs a migration hub (coordinator of an island model). Returns `true` if
+// the hub mode was requested.
+bool hub(const args_t &a)
+{
+  const auto value(a.at("--hub"));
+  if (!value)
+    return false;
+
+  vita::migration_hub h(value.asString());
+  if (h.listening())
+  {
+    vitaINFO << "Migration hub listening on " << value.asString();
+    h.run();
+  }
+
+  return true;
+}
+
 // Sets the maximum number of generations without improvement in a run.
 void max_stuck_time(const args_t &a)
 {
@@ -410,6 +433,17 @@ void mate_zone(const args_t &a)
   vitaINFO << "Mate zone set to " << problem->env.mate_zone;
 }
 
+// Sets the address of the migration hub (island model).
+void migration(const args_t &a)
+{
+  const auto value(a.at("--migration"));
+  if (!value)
+    return;
+
+  problem->env.migration.coordinator = value.asString();
+  vitaINFO << "Migration hub set to " << value.asString();
+}
+
 // Sets the overall probability of mutation of the individuals that have
 // been selected as winners in a tournament.
 //
@@ -697,7 +731,8 @@ void verbosity(const args_t &a)
 
 }  // namespace ui
 
-void parse_command_line(int argc, char *const argv[])
+// Returns `false` if there isn't a search to perform.
+bool parse_command_line(int argc, char *const argv[])
 {
   auto args(docopt::docopt(USAGE,
                            {argv + 1, argv + argc},
@@ -707,6 +742,9 @@ void parse_command_line(int argc, char *const argv[])
 
   ui::verbosity(args);
 
+  if (ui::hub(args))
+    return false;
+
   ui::cache(args);
   ui::evaluator(args);
   ui::random_seed(args);
@@ -724,6 +762,7 @@ void parse_command_line(int argc, char *const argv[])
   ui::max_stuck_time(args);
   ui::set_runs(args);
   ui::mate_zone(args);
+  ui::migration(args);
   ui::arl(args);
   ui::threshold(args);
 
@@ -737,6 +776,8 @@ void parse_command_line(int argc, char *const argv[])
   ui::data(args);
   ui::symbols(args);
   ui::validation(args);
+
+  return true;
 }
 
 int main(int argc, char *const argv[])
@@ -746,7 +787,8 @@ int main(int argc, char *const argv[])
   vita::src_problem problem;
   ui::problem = &problem;
 
-  parse_command_line(argc, argv);
+  if (!parse_command_line(argc, argv))
+    return EXIT_SUCCESS;
 
   if (!problem.data().size())
     return EXIT_FAILURE;
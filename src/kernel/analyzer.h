@@ -13,7 +13,9 @@
 #if !defined(VITA_ANALYZER_H)
 #define      VITA_ANALYZER_H
 
-#include <map>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 #include "kernel/distribution.h"
 #include "kernel/symbol.h"
@@ -39,6 +41,16 @@ namespace vita
 /// - symbols appearing in the set (accessed via `begin()` / `end()` methods);
 /// - grouped information (`age_dist(unsigned)`, `fit_dist(unsigned)`).
 ///
+/// Symbol statistics are additive and can also be maintained incrementally
+/// (`add_symbols()` / `remove_symbols()`) while the distributions are
+/// refilled via `clear_values()` / `add_values()`. This way only the
+/// individuals changed since the last snapshot have to be scanned (see
+/// `evolution::get_stats()`).
+///
+/// Counters are stored in flat vectors indexed by `symbol::opcode()` and by
+/// group, so counting a gene is a single array increment. Analyzers filled
+/// independently (e.g. one per thread) can be combined via `merge()`.
+///
 template<class T>
 class analyzer
 {
@@ -53,9 +65,16 @@ public:
   analyzer();
 
   void add(const T &, const fitness_t &, unsigned = 0);
+  void merge(const analyzer &);
 
   void clear();
 
+  // Incremental update.
+  unsigned add_symbols(const T &);
+  void remove_symbols(const T &);
+  void add_values(unsigned, const fitness_t &, unsigned, unsigned = 0);
+  void clear_values();
+
   std::uintmax_t functions(bool) const;
   std::uintmax_t terminals(bool) const;
 
@@ -66,10 +85,7 @@ public:
   const distribution<double> &age_dist(unsigned) const;
   const distribution<fitness_t> &fit_dist(unsigned) const;
 
-  /// Type returned by begin() and end() methods to iterate through the
-  /// statistics of the various symbols.
-  using const_iterator =
-    typename std::map<const symbol *, sym_counter>::const_iterator;
+  class const_iterator;
 
   const_iterator begin() const;
   const_iterator end() const;
@@ -77,31 +93,23 @@ public:
   bool debug() const;
 
 private:
-  void count(const symbol *, bool);
-  unsigned count(const T &);
-  unsigned count_team(const T &, std::true_type);
-  template<class U> unsigned count_team(const U &, std::false_type);
-  template<class U> unsigned count_introns(const U &, std::true_type);
-  template<class U> unsigned count_introns(const U &, std::false_type);
-
-  // This comparator is useful for debugging purpose: when we insert a
-  // symbol pointer in an ordered container, it induces a well defined
-  // order. Without this the default comparison for pointers has a
-  // unspecified (and not necessarily stable & consistent) behaviour.
-  // Well defined order means a simple way of debugging statistics.
-  struct cmp_symbol_ptr
-  {
-    bool operator()(const symbol *a, const symbol *b) const
-    { return a->opcode() < b->opcode(); }
-  };
-  std::map<const symbol *, sym_counter, cmp_symbol_ptr> sym_counter_;
+  void count(const symbol *, bool, bool);
+  unsigned count(const T &, bool);
+  unsigned count_team(const T &, bool, std::true_type);
+  template<class U> unsigned count_team(const U &, bool, std::false_type);
+  template<class U> unsigned count_introns(const U &, bool, std::true_type);
+  template<class U> unsigned count_introns(const U &, bool, std::false_type);
+
+  // Indexed by opcode. Iteration follows the opcode order, which is well
+  // defined (unlike the order of the pointers) and simplifies debugging.
+  std::vector<std::pair<const symbol *, sym_counter>> sym_counter_;
 
   struct group_stat
   {
     distribution<double>        age;
     distribution<fitness_t> fitness;
   };
-  std::map<unsigned, group_stat> group_stat_;
+  std::vector<group_stat> group_stat_;  // indexed by group
 
   distribution<fitness_t> fit_;
   distribution<double>    age_;
@@ -111,6 +119,57 @@ private:
   sym_counter terminals_;
 };  // analyzer
 
+///
+/// Iterator over the statistics of the symbols seen by an analyzer.
+///
+/// Dereferencing gives a `(symbol, counters)` pair. Opcodes without
+/// occurrences are skipped.
+///
+template<class T>
+class analyzer<T>::const_iterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::pair<const symbol *, sym_counter>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type *;
+  using reference = const value_type &;
+
+  using base = typename std::vector<value_type>::const_iterator;
+
+  const_iterator(base i, base end) : i_(i), end_(end) { skip(); }
+
+  const_iterator &operator++()
+  {
+    ++i_;
+    skip();
+    return *this;
+  }
+
+  const_iterator operator++(int)
+  {
+    const_iterator tmp(*this);
+    operator++();
+    return tmp;
+  }
+
+  bool operator==(const const_iterator &rhs) const { return i_ == rhs.i_; }
+  bool operator!=(const const_iterator &rhs) const { return i_ != rhs.i_; }
+
+  reference operator*() const { return *i_; }
+  pointer operator->() const { return &*i_; }
+
+private:
+  void skip()
+  {
+    while (i_ != end_ && !i_->second.counter[false]
+           && !i_->second.counter[true])
+      ++i_;
+  }
+
+  base i_, end_;
+};
+
 #include "kernel/analyzer.tcc"
 }  // namespace vita
 
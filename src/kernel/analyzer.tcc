@@ -32,14 +32,25 @@ analyzer<T>::analyzer()
 template<class T>
 void analyzer<T>::clear()
 {
-  age_.clear();
-  fit_.clear();
-  length_.clear();
+  clear_values();
 
   functions_ = sym_counter();
   terminals_ = sym_counter();
 
   sym_counter_.clear();
+}
+
+///
+/// Resets the distributions (age, fitness, length) keeping the symbol
+/// statistics.
+///
+template<class T>
+void analyzer<T>::clear_values()
+{
+  age_.clear();
+  fit_.clear();
+  length_.clear();
+
   group_stat_.clear();
 }
 
@@ -50,7 +61,7 @@ void analyzer<T>::clear()
 template<class T>
 typename analyzer<T>::const_iterator analyzer<T>::begin() const
 {
-  return sym_counter_.begin();
+  return const_iterator(sym_counter_.begin(), sym_counter_.end());
 }
 
 ///
@@ -59,7 +70,7 @@ typename analyzer<T>::const_iterator analyzer<T>::begin() const
 template<class T>
 typename analyzer<T>::const_iterator analyzer<T>::end() const
 {
-  return sym_counter_.end();
+  return const_iterator(sym_counter_.end(), sym_counter_.end());
 }
 
 ///
@@ -101,11 +112,10 @@ const distribution<double> &analyzer<T>::age_dist() const
 template<class T>
 const distribution<double> &analyzer<T>::age_dist(unsigned g) const
 {
-  const auto gi(group_stat_.find(g));
-  assert(gi != group_stat_.end());
+  assert(g < group_stat_.size());
 
-  Ensures(gi->second.age.debug());
-  return gi->second.age;
+  Ensures(group_stat_[g].age.debug());
+  return group_stat_[g].age;
 }
 
 ///
@@ -126,11 +136,10 @@ const distribution<fitness_t> &analyzer<T>::fit_dist() const
 template<class T>
 const distribution<fitness_t> &analyzer<T>::fit_dist(unsigned g) const
 {
-  const auto gi(group_stat_.find(g));
-  assert(gi != group_stat_.end());
+  assert(g < group_stat_.size());
 
-  Ensures(gi->second.fitness.debug());
-  return gi->second.fitness;
+  Ensures(group_stat_[g].fitness.debug());
+  return group_stat_[g].fitness;
 }
 
 ///
@@ -146,20 +155,36 @@ const distribution<double> &analyzer<T>::length_dist() const
 ///
 /// \param[in] sym    symbol we are gathering statistics about
 /// \param[in] active is this an active gene?
+/// \param[in] undo   `true` to remove a previously counted occurrence
 ///
-/// Used by `count(const T &)`.
+/// Used by `count(const T &, bool)`.
 ///
 template<class T>
-void analyzer<T>::count(const symbol *sym, bool active)
+void analyzer<T>::count(const symbol *sym, bool active, bool undo)
 {
   Expects(sym);
 
-  ++sym_counter_[sym].counter[active];
+  auto &c(sym->terminal() ? terminals_ : functions_);
+
+  const auto op(sym->opcode());
+  if (op >= sym_counter_.size())
+    sym_counter_.resize(op + 1);
+
+  auto &slot(sym_counter_[op]);
+  slot.first = sym;
+
+  if (undo)
+  {
+    Expects(slot.second.counter[active]);
 
-  if (sym->terminal())
-    ++terminals_.counter[active];
+    --slot.second.counter[active];
+    --c.counter[active];
+  }
   else
-    ++functions_.counter[active];
+  {
+    ++slot.second.counter[active];
+    ++c.counter[active];
+  }
 }
 
 ///
@@ -168,9 +193,16 @@ void analyzer<T>::count(const symbol *sym, bool active)
 template<class T>
 bool analyzer<T>::debug() const
 {
-  for (const auto &i : sym_counter_)
+  for (opcode_t op(0); op < sym_counter_.size(); ++op)
+  {
+    const auto &i(sym_counter_[op]);
+
+    if (i.first && i.first->opcode() != op)
+      return false;
+
     if (i.second.counter[true] > i.second.counter[false])
       return false;
+  }
 
   if (!age_.debug())
     return false;
@@ -194,10 +226,51 @@ bool analyzer<T>::debug() const
 template<class T>
 void analyzer<T>::add(const T &ind, const fitness_t &f, unsigned g)
 {
-  age_.add(ind.age());
-  group_stat_[g].age.add(ind.age());
+  add_values(ind.age(), f, add_symbols(ind), g);
+}
+
+///
+/// Adds the symbols of an individual to the symbol statistics.
+///
+/// \param[in] ind an individual
+/// \return        effective length of `ind` (to be passed to `add_values`)
+///
+template<class T>
+unsigned analyzer<T>::add_symbols(const T &ind)
+{
+  return count(ind, false);
+}
+
+///
+/// Removes the symbols of an individual from the symbol statistics.
+///
+/// \param[in] ind an individual previously added via `add_symbols`
+///
+template<class T>
+void analyzer<T>::remove_symbols(const T &ind)
+{
+  count(ind, true);
+}
 
-  length_.add(count(ind));
+///
+/// Adds the values describing an individual to the distributions.
+///
+/// \param[in] age    age of the individual
+/// \param[in] f      fitness of the individual
+/// \param[in] length effective length of the individual
+/// \param[in] g      a group of the population
+///
+template<class T>
+void analyzer<T>::add_values(unsigned age, const fitness_t &f,
+                             unsigned length, unsigned g)
+{
+  if (g >= group_stat_.size())
+    group_stat_.resize(g + 1);
+
+  age_.add(age);
+  group_stat_[g].age.add(age);
+
+  length_.add(length);
 
   if (isfinite(f))
   {
@@ -206,16 +279,64 @@ void analyzer<T>::add(const T &ind, const fitness_t &f, unsigned g)
   }
 }
 
+///
+/// Adds the statistics gathered by another analyzer.
+///
+/// \param[in] az an analyzer (e.g. filled by a different thread)
+///
+/// After the call `*this` describes the union of the two sets of
+/// individuals.
+///
+template<class T>
+void analyzer<T>::merge(const analyzer &az)
+{
+  if (az.sym_counter_.size() > sym_counter_.size())
+    sym_counter_.resize(az.sym_counter_.size());
+
+  for (std::size_t op(0); op < az.sym_counter_.size(); ++op)
+  {
+    const auto &src(az.sym_counter_[op]);
+    if (src.first)
+    {
+      auto &dst(sym_counter_[op]);
+
+      dst.first = src.first;
+      dst.second.counter[false] += src.second.counter[false];
+      dst.second.counter[true] += src.second.counter[true];
+    }
+  }
+
+  for (bool active : {false, true})
+  {
+    functions_.counter[active] += az.functions_.counter[active];
+    terminals_.counter[active] += az.terminals_.counter[active];
+  }
+
+  if (az.group_stat_.size() > group_stat_.size())
+    group_stat_.resize(az.group_stat_.size());
+
+  for (std::size_t g(0); g < az.group_stat_.size(); ++g)
+  {
+    group_stat_[g].age.merge(az.group_stat_[g].age);
+    group_stat_[g].fitness.merge(az.group_stat_[g].fitness);
+  }
+
+  age_.merge(az.age_);
+  fit_.merge(az.fit_);
+  length_.merge(az.length_);
+}
+
 ///
 /// \tparam T type of individual
 ///
-/// \param[in] ind individual to be analyzed
-/// \return        effective length of individual we gathered statistics about
+/// \param[in] ind  individual to be analyzed
+/// \param[in] undo `true` to remove the symbols of `ind`
+/// \return         effective length of individual we gathered statistics about
 ///
 template<class T>
-unsigned analyzer<T>::count(const T &ind)
+unsigned analyzer<T>::count(const T &ind, bool undo)
 {
-  return count_team(ind, is_team<T>());
+  return count_team(ind, undo, is_team<T>());
 }
 
 ///
@@ -223,21 +344,21 @@ unsigned analyzer<T>::count(const T &ind)
 ///
 template<class T>
 template<class U>
-unsigned analyzer<T>::count_team(const U &ind, std::false_type)
+unsigned analyzer<T>::count_team(const U &ind, bool undo, std::false_type)
 {
-  return count_introns(ind, has_introns<T>());
+  return count_introns(ind, undo, has_introns<T>());
 }
 
 ///
 /// Specialization of `count_team(T)` for teams.
 ///
 template<class T>
-unsigned analyzer<T>::count_team(const T &t, std::true_type)
+unsigned analyzer<T>::count_team(const T &t, bool undo, std::true_type)
 {
   unsigned length(0);
 
   for (const auto &ind : t)
-    length += count_team(ind, std::false_type());
+    length += count_team(ind, undo, std::false_type());
 
   return length;
 }
@@ -247,13 +368,13 @@ unsigned analyzer<T>::count_team(const T &t, std::true_type)
 ///
 template<class T>
 template<class U>
-unsigned analyzer<T>::count_introns(const U &ind, std::true_type)
+unsigned analyzer<T>::count_introns(const U &ind, bool undo, std::true_type)
 {
   for (index_t i(0); i < ind.size(); ++i)
     for (category_t c(0); c < ind.categories(); ++c)
-      count(ind[{i, c}].sym, false);
+      count(ind[{i, c}].sym, false, undo);
 
-  return count_introns(ind, std::false_type());
+  return count_introns(ind, undo, std::false_type());
 }
 
 ///
@@ -261,12 +382,12 @@ unsigned analyzer<T>::count_introns(const U &ind, std::true_type)
 ///
 template<class T>
 template<class U>
-unsigned analyzer<T>::count_introns(const U &ind, std::false_type)
+unsigned analyzer<T>::count_introns(const U &ind, bool undo, std::false_type)
 {
   unsigned length(0);
   for (const auto &g : ind)
   {
-    count(g.sym, true);
+    count(g.sym, true, undo);
     ++length;
   }
 
@@ -278,7 +399,7 @@ unsigned analyzer<T>::count_introns(const U &ind, std::false_type)
 /// \return        effective length of individual we gathered statistics about
 ///
 template<>
-inline unsigned analyzer<i_de>::count(const i_de &ind)
+inline unsigned analyzer<i_de>::count(const i_de &ind, bool)
 {
   return ind.parameters();
 }
@@ -288,7 +409,7 @@ inline unsigned analyzer<i_de>::count(const i_de &ind)
 /// \return        effective length of individual we gathered statistics about
 ///
 template<>
-inline unsigned analyzer<i_ga>::count(const i_ga &ind)
+inline unsigned analyzer<i_ga>::count(const i_ga &ind, bool)
 {
   return ind.parameters();
 }
@@ -10,10 +10,45 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
+#include <cstring>
+
 #include "kernel/cache.h"
 
 namespace vita
 {
+
+namespace
+{
+constexpr char magic[8] = {'V', 'I', 'T', 'A', 'C', 'A', 'C', 'H'};
+constexpr std::uint32_t format_version = 1;
+
+// Magic string, version, seal, probes, hits, number of entries, size of the
+// entries.
+constexpr std::size_t header_size = sizeof(magic) + 2 * sizeof(std::uint32_t)
+                                    + 4 * sizeof(std::uint64_t);
+
+// Signature and size of the fitness.
+constexpr std::uint64_t min_record_size = 2 * sizeof(std::uint64_t)
+                                          + sizeof(std::uint32_t);
+
+template<class T> void write(std::string &out, T v)
+{
+  char buf[sizeof(v)];
+  std::memcpy(buf, &v, sizeof(v));
+  out.append(buf, sizeof(v));
+}
+
+template<class T> bool read(const std::string &in, std::size_t &pos, T *v)
+{
+  if (in.size() - pos < sizeof(*v))
+    return false;
+
+  std::memcpy(v, in.data() + pos, sizeof(*v));
+  pos += sizeof(*v);
+  return true;
+}
+}  // namespace
+
 ///
 /// Creates a new hash table.
 ///
@@ -98,55 +133,102 @@ const fitness_t &cache::find(const hash_t &h) const
 /// \param[in] h       a (possibly) new individual's signature to be stored in
 ///                    the table
 /// \param[in] fitness the fitness of the individual
+/// \return            `true` if a valid entry for a different individual has
+///                    been overwritten (eviction)
 ///
-void cache::insert(const hash_t &h, const fitness_t &fitness)
+bool cache::insert(const hash_t &h, const fitness_t &fitness)
 {
   slot s;
   s.hash    =       h;
   s.fitness = fitness;
   s.seal    =   seal_;
 
-  table_[index(s.hash)] = s;
+  auto &dest(table_[index(s.hash)]);
+  const bool evicted(dest.seal == seal_ && !dest.hash.empty()
+                     && dest.hash != h);
+
+  dest = s;
+  return evicted;
 }
 
 ///
 /// \param[in] in input stream
 /// \return       `true` if the object is correctly loaded
 ///
+/// The loaded entries replace the current content of the table.
+///
 /// \note
 /// If the load operation isn't successful the current object isn't changed.
 ///
+/// \see cache::save for a description of the format
+///
 bool cache::load(std::istream &in)
 {
-  decltype(seal_) t_seal;
-  if (!(in >> t_seal))
+  std::string data(header_size, '\0');
+  if (!in.read(data.data(), header_size)
+      || std::memcmp(data.data(), magic, sizeof(magic)))
     return false;
 
-  decltype(probes_) t_probes;
-  if (!(in >> t_probes))
-    return false;
+  std::size_t pos(sizeof(magic));
 
-  decltype(hits_) t_hits;
-  if (!(in >> t_hits))
+  std::uint32_t version, t_seal;
+  std::uint64_t t_probes, t_hits, n, payload;
+  if (!read(data, pos, &version) || version != format_version
+      || !read(data, pos, &t_seal) || !read(data, pos, &t_probes)
+      || !read(data, pos, &t_hits) || !read(data, pos, &n)
+      || !read(data, pos, &payload)
+      || n > table_.size() || payload < n * min_record_size)
     return false;
 
-  std::size_t n;
-  if (!(in >> n))
+  // The payload is read in chunks: a corrupted size field cannot trigger a
+  // huge allocation.
+  for (std::uint64_t left(payload + 2 * sizeof(std::uint64_t)); left;)
+  {
+    char buf[65536];
+    const auto chunk(std::min<std::uint64_t>(left, sizeof(buf)));
+    if (!in.read(buf, static_cast<std::streamsize>(chunk)))
+      return false;
+
+    data.append(buf, chunk);
+    left -= chunk;
+  }
+
+  const auto body(data.size() - 2 * sizeof(std::uint64_t));
+
+  hash_t stored;
+  pos = body;
+  if (!read(data, pos, &stored.data[0]) || !read(data, pos, &stored.data[1])
+      || stored != murmurhash3::hash128(data.data(), body))
     return false;
 
-  for (decltype(n) i(0); i < n; ++i)
+  std::vector<slot> t_slots(n);
+  pos = header_size;
+  for (auto &s : t_slots)
   {
-    slot s;
-    s.seal = t_seal;
-
-    if (!s.hash.load(in))
+    if (body - pos < min_record_size)
       return false;
-    if (!s.fitness.load(in))
+
+    std::uint32_t size;
+    if (!read(data, pos, &s.hash.data[0]) || !read(data, pos, &s.hash.data[1])
+        || !read(data, pos, &size) || (body - pos) / sizeof(double) < size)
       return false;
 
-    table_[index(s.hash)] = s;
+    s.fitness = fitness_t(with_size(size));
+    for (std::size_t i(0); i < size; ++i)
+      if (!read(data, pos, &s.fitness[i]))
+        return false;
+
+    s.seal = t_seal;
   }
 
+  if (pos != body)
+    return false;
+
+  for (auto &s : table_)
+    s.seal = 0;
+  for (const auto &s : t_slots)
+    table_[index(s.hash)] = s;
+
   seal_   = t_seal;
   probes_ = t_probes;
   hits_   = t_hits;
@@ -158,24 +240,52 @@ bool cache::load(std::istream &in)
 /// \param[out] out output stream
 /// \return         `true` if the object was saved correctly
 ///
+/// The content of the table is saved in a binary format and written with a
+/// single sequential write:
+/// - an 8 bytes magic string and the format version (`std::uint32_t`);
+/// - seal (`std::uint32_t`), probes and hits (`std::uint64_t`);
+/// - number of entries and size in bytes of the entries (`std::uint64_t`);
+/// - the entries: signature (two `std::uint64_t`), size of the fitness
+///   (`std::uint32_t`) and its components (`double`);
+/// - a 128 bit checksum of all the preceding bytes.
+///
+/// Only the valid entries are saved. Integers are stored in the byte order of
+/// the host.
+///
 bool cache::save(std::ostream &out) const
 {
-  out << seal_ << ' ' << probes_ << ' ' << hits_ << '\n';
-
-  std::size_t num(0);
-  for (const auto &s : table_)
-    if (!s.hash.empty())
-      ++num;
-  out << num << '\n';
+  std::string entries;
+  std::uint64_t n(0);
 
   for (const auto &s : table_)
     if (s.seal == seal_ && !s.hash.empty())
     {
-      s.hash.save(out);
-      s.fitness.save(out);
+      write(entries, s.hash.data[0]);
+      write(entries, s.hash.data[1]);
+      write(entries, static_cast<std::uint32_t>(s.fitness.size()));
+      for (const auto f : s.fitness)
+        write(entries, f);
+
+      ++n;
     }
 
-  return out.good();
+  std::string data(magic, sizeof(magic));
+  data.reserve(header_size + entries.size() + 2 * sizeof(std::uint64_t));
+
+  write(data, format_version);
+  write(data, static_cast<std::uint32_t>(seal_));
+  write(data, static_cast<std::uint64_t>(probes_));
+  write(data, static_cast<std::uint64_t>(hits_));
+  write(data, n);
+  write(data, static_cast<std::uint64_t>(entries.size()));
+  data += entries;
+
+  const auto h(murmurhash3::hash128(data.data(), data.size()));
+  write(data, h.data[0]);
+  write(data, h.data[1]);
+
+  return static_cast<bool>(
+    out.write(data.data(), static_cast<std::streamsize>(data.size())));
 }
 
 ///
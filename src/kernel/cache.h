@@ -36,7 +36,7 @@ public:
   void clear();
   void clear(const hash_t &);
 
-  void insert(const hash_t &, const fitness_t &);
+  bool insert(const hash_t &, const fitness_t &);
 
   const fitness_t &find(const hash_t &) const;
 
@@ -0,0 +1,242 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if !defined(WIN32) && !defined(_WIN32) && !defined(__WIN32)
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define VITA_CHECKPOINT_FSYNC
+#endif
+
+#include "kernel/checkpoint.h"
+#include "kernel/cache_hash.h"
+
+namespace vita
+{
+
+namespace
+{
+constexpr char magic[8] = {'V', 'I', 'T', 'A', 'C', 'K', 'P', 'T'};
+
+template<class T> void write(std::string &out, T v)
+{
+  char buf[sizeof(v)];
+  std::memcpy(buf, &v, sizeof(v));
+  out.append(buf, sizeof(v));
+}
+
+template<class T> bool read(const std::string &in, std::size_t &pos, T *v)
+{
+  if (in.size() - pos < sizeof(*v))
+    return false;
+
+  std::memcpy(v, in.data() + pos, sizeof(*v));
+  pos += sizeof(*v);
+  return true;
+}
+
+hash_t checksum(const std::string &data, std::size_t len)
+{
+  return murmurhash3::hash128(data.data(), len);
+}
+
+// Forces the content of a file to the storage device (where supported): a
+// rename that survives a crash mustn't point to data still in the page
+// cache.
+bool sync(const std::filesystem::path &p)
+{
+#if defined(VITA_CHECKPOINT_FSYNC)
+  const int fd(::open(p.c_str(), O_RDONLY));
+  if (fd < 0)
+    return false;
+
+  const bool ok(::fsync(fd) == 0);
+  return ::close(fd) == 0 && ok;
+#else
+  (void)p;
+  return true;
+#endif
+}
+}  // namespace
+
+///
+/// \param[in] name name of a section
+/// \return         `true` if the section is available
+///
+bool checkpoint::has(const std::string &name) const
+{
+  return sections_.find(name) != sections_.end();
+}
+
+///
+/// \param[in] name name of a section
+/// \return         a stream for reading the content of the section (an empty
+///                 stream if the section is missing)
+///
+std::istringstream checkpoint::get(const std::string &name) const
+{
+  const auto it(sections_.find(name));
+  return std::istringstream(it == sections_.end() ? std::string()
+                                                  : it->second);
+}
+
+///
+/// Adds / replaces a section.
+///
+/// \param[in] name    name of the section
+/// \param[in] content content of the section
+///
+void checkpoint::set(const std::string &name, std::string content)
+{
+  sections_[name] = std::move(content);
+}
+
+///
+/// \return `true` if the checkpoint doesn't contain any section
+///
+bool checkpoint::empty() const
+{
+  return sections_.empty();
+}
+
+///
+/// Removes every section.
+///
+void checkpoint::clear()
+{
+  sections_.clear();
+}
+
+///
+/// \param[in] p path of a checkpoint file
+/// \return      `true` if the checkpoint has been loaded correctly
+///
+/// \note
+/// If the load operation isn't successful the current object isn't changed.
+///
+bool checkpoint::load(const std::filesystem::path &p)
+{
+  std::ifstream in(p, std::ios::binary);
+  if (!in)
+    return false;
+
+  const std::string data(std::istreambuf_iterator<char>(in), {});
+
+  const auto hash_size(2 * sizeof(std::uint64_t));
+  if (data.size() < sizeof(magic) + hash_size
+      || std::memcmp(data.data(), magic, sizeof(magic)))
+    return false;
+
+  const auto body(data.size() - hash_size);
+
+  hash_t stored;
+  std::size_t pos(body);
+  if (!read(data, pos, &stored.data[0]) || !read(data, pos, &stored.data[1])
+      || stored != checksum(data, body))
+    return false;
+
+  pos = sizeof(magic);
+
+  std::uint32_t v, n;
+  if (!read(data, pos, &v) || v != version || !read(data, pos, &n))
+    return false;
+
+  decltype(sections_) tmp;
+  for (std::uint32_t i(0); i < n; ++i)
+  {
+    std::uint32_t name_len;
+    if (!read(data, pos, &name_len) || body - pos < name_len)
+      return false;
+    std::string name(data, pos, name_len);
+    pos += name_len;
+
+    std::uint64_t len;
+    if (!read(data, pos, &len) || body - pos < len)
+      return false;
+    tmp[name] = data.substr(pos, len);
+    pos += len;
+  }
+
+  if (pos != body)
+    return false;
+
+  sections_ = tmp;
+  return true;
+}
+
+///
+/// \param[in] p path of the checkpoint file
+/// \return      `true` if the checkpoint has been saved correctly
+///
+/// The file is replaced atomically (as far as the file system allows): the
+/// new content is written and synced to a temporary file, the current file
+/// becomes the previous checkpoint and then the temporary file is renamed.
+/// If the new content cannot be written the existing files aren't touched.
+///
+bool checkpoint::save(const std::filesystem::path &p) const
+{
+  std::string data(magic, sizeof(magic));
+  write(data, version);
+  write(data, static_cast<std::uint32_t>(sections_.size()));
+
+  for (const auto &[name, content] : sections_)
+  {
+    write(data, static_cast<std::uint32_t>(name.size()));
+    data += name;
+    write(data, static_cast<std::uint64_t>(content.size()));
+    data += content;
+  }
+
+  const auto h(checksum(data, data.size()));
+  write(data, h.data[0]);
+  write(data, h.data[1]);
+
+  auto tmp(p);
+  tmp += ".tmp";
+
+  std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+  out.write(data.data(), static_cast<std::streamsize>(data.size()));
+  out.close();
+
+  std::error_code ec;
+  if (!out || !sync(tmp))
+  {
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+
+  // The last valid checkpoint is kept aside until the new one is in place.
+  if (std::filesystem::exists(p, ec))
+    std::filesystem::rename(p, previous(p), ec);
+
+  if (!ec)
+    std::filesystem::rename(tmp, p, ec);
+  return !ec;
+}
+
+///
+/// \param[in] p path of a checkpoint file
+/// \return      path of the copy of the checkpoint preceding the one in `p`
+///
+/// \see save
+///
+std::filesystem::path checkpoint::previous(const std::filesystem::path &p)
+{
+  auto ret(p);
+  ret += ".prev";
+  return ret;
+}
+
+}  // namespace vita
@@ -0,0 +1,70 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_CHECKPOINT_H)
+#define      VITA_CHECKPOINT_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace vita
+{
+///
+/// The complete state of a search, saved to resume it later.
+///
+/// A checkpoint is a set of named sections. Every component of the search
+/// fills its own section(s) via its usual serialization functions; the
+/// checkpoint only takes care of the container.
+///
+/// The container is a binary file:
+/// - an 8 bytes magic string and the format version (`std::uint32_t`);
+/// - the number of sections (`std::uint32_t`);
+/// - for every section the length of the name (`std::uint32_t`), the name,
+///   the length of the content (`std::uint64_t`) and the content;
+/// - a 128 bit checksum of all the preceding bytes.
+///
+/// Integers are stored in the byte order of the host.
+///
+/// A checkpoint is written to a temporary file which then replaces the
+/// previous one: a crash while saving doesn't destroy the last valid
+/// checkpoint. A truncated / corrupted file is detected via the checksum and
+/// rejected. The replaced checkpoint is kept (see `previous()`) as a
+/// fallback.
+///
+class checkpoint
+{
+public:
+  static constexpr std::uint32_t version = 1;
+
+  bool has(const std::string &) const;
+  std::istringstream get(const std::string &) const;
+  void set(const std::string &, std::string);
+
+  bool empty() const;
+  void clear();
+
+  // Serialization.
+  bool load(const std::filesystem::path &);
+  bool save(const std::filesystem::path &) const;
+
+  static std::filesystem::path previous(const std::filesystem::path &);
+
+private:
+  std::map<std::string, std::string> sections_;
+};
+
+}  // namespace vita
+
+#endif  // include guard
@@ -41,6 +41,7 @@ public:
   fitness_t fast(const T &) override;
 
   std::unique_ptr<basic_lambda_f> lambdify(const T &) const override;
+  perf_counters counters() const override;
 
 private:
   // Base evaluator.
@@ -61,4 +61,13 @@ std::unique_ptr<basic_lambda_f> constrained_evaluator<T, E, P>::lambdify(
   return eva_.lambdify(prg);
 }
 
+///
+/// \return the counters of the base evaluator
+///
+template<class T, class E, class P>
+perf_counters constrained_evaluator<T, E, P>::counters() const
+{
+  return eva_.counters();
+}
+
 #endif  // include guard
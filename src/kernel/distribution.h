@@ -13,34 +13,53 @@
 #if !defined(VITA_DISTRIBUTION_H)
 #define      VITA_DISTRIBUTION_H
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <iterator>
 #include <map>
+#include <type_traits>
 
 #include "kernel/log.h"
+#include "utility/contracts.h"
 #include "utility/utility.h"
 
 namespace vita
 {
 ///
 /// Simplifies the calculation of statistics regarding a sequence (mean,
-/// variance, standard deviation, entropy, min and max).
+/// variance, standard deviation, entropy, quantiles, min and max).
+///
+/// Mean, variance, min and max are exact and require constant memory. Entropy
+/// and quantiles are computed from a histogram (`seen()`) of at most
+/// `2 * max_bins` bins: when the limit is exceeded adjacent bins are merged
+/// (see `compact`). So long runs with continuous values (e.g. one distinct
+/// fitness per evaluation) don't accumulate unbounded memory.
+///
+/// \remark
+/// As long as there are fewer than `2 * max_bins` distinct (rounded) values
+/// the histogram is exact.
 ///
 template<class T>
 class distribution
 {
 public:
+  /// Number of bins retained by the histogram after a compaction.
+  static constexpr std::size_t max_bins = 1024;
+
   distribution();
 
   void clear();
 
   void add(T);
+  void merge(const distribution &);
 
   std::uintmax_t count() const;
   double entropy() const;
   T max() const;
   T mean() const;
   T min() const;
+  T quantile(double) const;
   const std::map<T, std::uintmax_t> &seen() const;
   T standard_deviation() const;
   T variance() const;
@@ -52,6 +71,7 @@ public:   // Serialization
   bool save(std::ostream &) const;
 
 private:  // Private methods
+  void compact();
   void update_variance(T);
 
 private:  // Private data members
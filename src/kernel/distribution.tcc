@@ -105,17 +105,135 @@ void distribution<T>::add(T val)
     ++count_;
 
     ++seen_[round_to(val)];
+    if (seen_.size() > 2 * max_bins)
+      compact();
 
     update_variance(val);
   }
 }
 
+///
+/// Adds the values of another distribution.
+///
+/// \param[in] d a distribution (e.g. gathered by a different thread)
+///
+/// The result is the distribution of the union of the two sequences. Mean
+/// and variance are combined via the pairwise formula of Chan et al.
+/// (<https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance>).
+///
+template<class T>
+void distribution<T>::merge(const distribution &d)
+{
+  if (!d.count())
+    return;
+
+  if (!count())
+  {
+    *this = d;
+    return;
+  }
+
+  if (d.min() < min())
+    min_ = d.min();
+  if (d.max() > max())
+    max_ = d.max();
+
+  const auto n1(static_cast<double>(count()));
+  const auto n2(static_cast<double>(d.count()));
+  const auto n(n1 + n2);
+
+  const T delta(d.mean() - mean());
+  mean_ += delta * (n2 / n);
+  m2_ += d.m2_ + delta * delta * (n1 * n2 / n);
+
+  count_ += d.count();
+
+  for (const auto &b : d.seen())
+    seen_[b.first] += b.second;
+  if (seen_.size() > 2 * max_bins)
+    compact();
+}
+
+///
+/// Merges adjacent bins of the histogram.
+///
+/// Consecutive bins are joined while their total count doesn't exceed
+/// `w = 2 * count() / max_bins`; the resulting bin is represented by the key
+/// of its most populated component. Since two adjacent bins of the result
+/// always sum to more than `w`, at most `max_bins + 1` bins survive.
+///
+/// A merged bin contains at most `w` values so the rank error of
+/// `quantile()` is bounded by `2 / max_bins`. The entropy can only decrease
+/// (merging is a function of the observed values).
+///
+template<class T>
+void distribution<T>::compact()
+{
+  const auto w(std::max<std::uintmax_t>(2 * count() / max_bins, 1));
+
+  decltype(seen_) s;
+  for (auto it(seen_.begin()); it != seen_.end();)
+  {
+    auto key(it->first);
+    auto n(it->second), best(it->second);
+
+    for (++it; it != seen_.end() && n + it->second <= w; ++it)
+    {
+      if (it->second > best)
+      {
+        key = it->first;
+        best = it->second;
+      }
+
+      n += it->second;
+    }
+
+    s.emplace_hint(s.end(), key, n);
+  }
+
+  seen_.swap(s);
+}
+
+///
+/// \return the histogram of the (rounded) values of the distribution:
+///         representative value -> number of sightings
+///
+/// \remark
+/// The histogram has a bounded number of bins (see `compact`).
+///
 template<class T>
 const std::map<T, std::uintmax_t> &distribution<T>::seen() const
 {
   return seen_;
 }
 
+///
+/// \param[in] q a probability in the `[0, 1]` interval
+/// \return      the `q`-quantile of the distribution
+///
+/// The result is the representative value of the first bin of the histogram
+/// whose cumulative count reaches `q * count()`. It's exact until the first
+/// compaction; after that the rank error is at most `2 / max_bins`.
+///
+template<class T>
+T distribution<T>::quantile(double q) const
+{
+  Expects(0.0 <= q && q <= 1.0);
+  Expects(count());
+
+  const auto target(q * static_cast<double>(count()));
+
+  std::uintmax_t cumulative(0);
+  for (const auto &b : seen())
+  {
+    cumulative += b.second;
+    if (static_cast<double>(cumulative) >= target)
+      return b.first;
+  }
+
+  return std::prev(seen().end())->first;
+}
+
 ///
 /// \return the entropy of the distribution.
 ///
@@ -188,22 +306,44 @@ T distribution<T>::standard_deviation() const
 ///
 /// Saves the distribution on persistent storage.
 ///
+/// \remark
+/// Floating point values are written in a human readable format. Other types
+/// (e.g. `fitness_t`) use their own `save` member function.
+///
 template<class T>
 bool distribution<T>::save(std::ostream &out) const
 {
   SAVE_FLAGS(out);
 
-  out << count() << '\n'
-      << std::fixed << std::scientific
-      << std::setprecision(std::numeric_limits<T>::digits10 + 1)
-      << mean() << '\n'
-      << min()  << '\n'
-      << max()  << '\n'
-      << m2_ << '\n';
+  if constexpr (std::is_floating_point_v<T>)
+  {
+    out << count() << '\n'
+        << std::fixed << std::scientific
+        << std::setprecision(std::numeric_limits<T>::digits10 + 1)
+        << mean() << '\n'
+        << min()  << '\n'
+        << max()  << '\n'
+        << m2_ << '\n';
+
+    out << seen().size() << '\n';
+    for (const auto &elem : seen())
+      out << elem.first << ' ' << elem.second << '\n';
+  }
+  else
+  {
+    out << count() << '\n';
+    if (!mean_.save(out) || !min_.save(out) || !max_.save(out)
+        || !m2_.save(out))
+      return false;
 
-  out << seen().size() << '\n';
-  for (const auto &elem : seen())
-    out << elem.first << ' ' << elem.second << '\n';
+    out << seen().size() << '\n';
+    for (const auto &elem : seen())
+    {
+      if (!elem.first.save(out))
+        return false;
+      out << elem.second << '\n';
+    }
+  }
 
   return out.good();
 }
@@ -222,6 +362,14 @@ bool distribution<T>::load(std::istream &in)
 {
   SAVE_FLAGS(in);
 
+  const auto load_value([&in](T *v)
+                        {
+                          if constexpr (std::is_floating_point_v<T>)
+                            return static_cast<bool>(in >> *v);
+                          else
+                            return v->load(in);
+                        });
+
   decltype(count_) c;
   if (!(in >> c))
     return false;
@@ -230,19 +378,19 @@ bool distribution<T>::load(std::istream &in)
      >> std::setprecision(std::numeric_limits<T>::digits10 + 1);
 
   decltype(mean_) m;
-  if (!(in >> m))
+  if (!load_value(&m))
     return false;
 
   decltype(min_) mn;
-  if (!(in >> mn))
+  if (!load_value(&mn))
     return false;
 
   decltype(max_) mx;
-  if (!(in >> mx))
+  if (!load_value(&mx))
     return false;
 
   decltype(m2_) m2__;
-  if (!(in >> m2__))
+  if (!load_value(&m2__))
     return false;
 
   typename decltype(seen_)::size_type n;
@@ -254,7 +402,7 @@ bool distribution<T>::load(std::istream &in)
   {
     typename decltype(seen_)::key_type key;
     typename decltype(seen_)::mapped_type val;
-    if (!(in >> key >> val))
+    if (!load_value(&key) || !(in >> val))
       return false;
 
     s[key] = val;
@@ -94,6 +94,7 @@ void environment::xml(tinyxml2::XMLDocument *d) const
   if (validation_percentage.has_value())
     set_text(e_environment, "validation_percentage", *validation_percentage);
   set_text(e_environment, "cache_bits", cache_size);  // size `1u<<cache_size`
+  set_text(e_environment, "evaluations_in_flight", evaluations_in_flight);
 
   auto *e_alps(d->NewElement("alps"));
   e_environment->InsertEndChild(e_alps);
@@ -104,6 +105,12 @@ void environment::xml(tinyxml2::XMLDocument *d) const
   e_environment->InsertEndChild(e_team);
   set_text(e_team, "individuals", team.individuals);
 
+  auto *e_migration(d->NewElement("migration"));
+  e_environment->InsertEndChild(e_migration);
+  set_text(e_migration, "coordinator", migration.coordinator);
+  set_text(e_migration, "interval", migration.interval);
+  set_text(e_migration, "migrants", migration.migrants);
+
   auto *e_statistics(d->NewElement("statistics"));
   e_environment->InsertEndChild(e_statistics);
   set_text(e_statistics, "directory", stat.dir);
@@ -111,13 +118,18 @@ void environment::xml(tinyxml2::XMLDocument *d) const
   set_text(e_statistics, "save_dynamics", stat.dynamic_file);
   set_text(e_statistics, "save_layers", stat.layers_file);
   set_text(e_statistics, "save_population", stat.population_file);
+  set_text(e_statistics, "binary_population", stat.binary_population);
   set_text(e_statistics, "save_summary", stat.summary_file);
   set_text(e_statistics, "save_test", stat.test_file);
+  set_text(e_statistics, "save_trace", stat.trace_file);
   set_text(e_statistics, "individual_format", stat.ind_format);
 
   auto *e_misc(d->NewElement("misc"));
   e_environment->InsertEndChild(e_misc);
   set_text(e_misc, "serialization_file", misc.serialization_file);
+  set_text(e_misc, "checkpoint_file", misc.checkpoint_file);
+  set_text(e_misc, "checkpoint_interval", misc.checkpoint_interval);
+  set_text(e_misc, "shared_cache_dir", misc.shared_cache_dir);
 }
 
 ///
@@ -271,6 +283,24 @@ bool environment::debug(bool force_defined) const
     return false;
   }
 
+  if (!evaluations_in_flight)
+  {
+    vitaERROR << "`evaluations_in_flight` out of range";
+    return false;
+  }
+
+  if (!misc.checkpoint_interval)
+  {
+    vitaERROR << "`checkpoint_interval` out of range";
+    return false;
+  }
+
+  if (!migration.interval)
+  {
+    vitaERROR << "`migration.interval` out of range";
+    return false;
+  }
+
   if (min_individuals == 1)
   {
     vitaERROR << "At least 2 individuals for layer";
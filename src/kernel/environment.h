@@ -218,11 +218,38 @@ public:
   /// `2^cache_size` is the number of elements of the cache.
   unsigned cache_size = 16;
 
+  /// Maximum number of offspring whose evaluation is going on at the same
+  /// time (see `evaluator::async()`).
+  ///
+  /// With values greater than `1` the evolution doesn't wait for the fitness
+  /// of an offspring before producing the next one: results are integrated
+  /// into the population (replacement) in submission order, so a run is
+  /// still reproducible. The parents of an offspring could have been
+  /// replaced in the meantime (as in any steady-state asynchronous GP).
+  ///
+  /// \note Useful only with an evaluator supporting asynchronous requests
+  ///       (e.g. `evaluator_pool`).
+  unsigned evaluations_in_flight = 1;
+
   struct misc_parameters
   {
     /// Filename used for persistance. An empty name is used to skip
     /// serialization.
     std::string serialization_file = "";
+
+    /// File used to periodically save the complete state of the search (see
+    /// `checkpoint`). If the file exists when the search starts, the search
+    /// is resumed from the saved state. An empty name disables
+    /// checkpointing.
+    std::string checkpoint_file = "";
+
+    /// A checkpoint is saved every `checkpoint_interval` generations (and at
+    /// the end of every run).
+    unsigned checkpoint_interval = 1;
+
+    /// Directory of the fitness caches shared among processes working on
+    /// the same data (see `shared_cache`). An empty name disables sharing.
+    std::string shared_cache_dir = "";
   } misc;
 
   struct statistics
@@ -249,6 +276,10 @@ public:
     /// Enabling this log with large populations has a big performance impact.
     std::string population_file = "";
 
+    /// Writes the population log in a compact binary format (see
+    /// `population_log::binary_to_text` for the conversion to text).
+    bool binary_population = false;
+
     /// Name of the log file used to save a summary report.
     /// \note An empty string disable logging.
     std::string summary_file = "";
@@ -257,6 +288,14 @@ public:
     /// \name An empty string disable savings.
     std::string test_file = "";
 
+    /// Name of the file used to save the trace events of the search (Chrome
+    /// trace event format, see `trace`).
+    /// \note An empty string disable savings.
+    /// \remark
+    /// Events are recorded only when the framework is compiled with the
+    /// `VITA_TRACE` CMake option.
+    std::string trace_file = "";
+
     /// Default rendering format used to print an individual.
     out::print_format_t ind_format = out::list_f;
   } stat;
@@ -317,6 +356,24 @@ public:
     /// > 1 means team mode.
     unsigned individuals = 3;
   } team;
+
+  ///
+  /// Parameters for the island model: every island is a distinct process
+  /// (possibly on a distinct host) and individuals are exchanged via a
+  /// `migration_hub`.
+  ///
+  struct migration_parameters
+  {
+    /// Address of the hub (`unix:PATH` or `HOST:PORT`). An empty address
+    /// disables migration.
+    std::string coordinator = "";
+
+    /// Individuals are exchanged every `interval` generations.
+    unsigned interval = 10;
+
+    /// Number of individuals sent to the other islands at every exchange.
+    unsigned migrants = 1;
+  } migration;
 };  // class environment
 
 }  // namespace vita
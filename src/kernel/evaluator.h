@@ -13,9 +13,16 @@
 #if !defined(VITA_EVALUATOR_H)
 #define      VITA_EVALUATOR_H
 
+#include <filesystem>
+#include <future>
+#include <optional>
+
+#include "kernel/cache_hash.h"
 #include "kernel/fitness.h"
 #include "kernel/lambda_f.h"
+#include "kernel/perf_counters.h"
 #include "kernel/random.h"
+#include "utility/trace.h"
 
 namespace vita
 {
@@ -58,6 +65,9 @@ public:
   /// \return the fitness of the individual
   virtual fitness_t operator()(const T &) = 0;
 
+  virtual std::vector<fitness_t> batch(const std::vector<const T *> &);
+  virtual std::future<fitness_t> async(const T &);
+
   // Serialization.
   virtual bool load(std::istream &);
   virtual bool save(std::ostream &) const;
@@ -66,6 +76,49 @@ public:
   virtual fitness_t fast(const T &);
   virtual std::string info() const;
   virtual std::unique_ptr<basic_lambda_f> lambdify(const T &) const;
+  virtual perf_counters counters() const;
+  virtual bool share(const std::filesystem::path &, const hash_t &);
+};
+
+///
+/// Counts and times the requests forwarded to another evaluator.
+///
+/// \tparam T the type of individual used
+///
+/// Used by `evolution` to fill the performance counters of the summary
+/// without requiring any cooperation from user-defined evaluators.
+///
+template<class T>
+class metered_evaluator : public evaluator<T>
+{
+public:
+  explicit metered_evaluator(evaluator<T> &);
+
+  fitness_t operator()(const T &) override;
+  std::vector<fitness_t> batch(const std::vector<const T *> &) override;
+  std::future<fitness_t> async(const T &) override;
+  fitness_t fast(const T &) override;
+
+  fitness_t collect(const T &, std::future<fitness_t> &);
+  void forget();
+
+  bool load(std::istream &) override;
+  bool save(std::ostream &) const override;
+  void clear() override;
+
+  std::string info() const override;
+  std::unique_ptr<basic_lambda_f> lambdify(const T &) const override;
+  perf_counters counters() const override;
+  bool share(const std::filesystem::path &, const hash_t &) override;
+
+private:
+  evaluator<T> &eva_;
+
+  std::uintmax_t requests_;
+  std::chrono::nanoseconds elapsed_;
+
+  // Last result obtained via `collect` (signature / fitness).
+  std::optional<std::pair<hash_t, fitness_t>> collected_;
 };
 
 enum class test_evaluator_type {distinct, fixed, random};
@@ -17,6 +17,57 @@
 #if !defined(VITA_EVALUATOR_TCC)
 #define      VITA_EVALUATOR_TCC
 
+///
+/// Evaluates a group of individuals.
+///
+/// \param[in] prgs individuals to be evaluated
+/// \return         the fitnesses of the individuals (same order of `prgs`)
+///
+/// This is the entry point for evaluators which can take advantage of
+/// knowing many individuals at once (amortising setup costs, skipping
+/// duplicates, sharing common work, scheduling evaluations on multiple
+/// threads...).
+///
+/// \note Default implementation calls the standard fitness function for every
+///       individual.
+///
+template<class T>
+std::vector<fitness_t> evaluator<T>::batch(const std::vector<const T *> &prgs)
+{
+  std::vector<fitness_t> ret;
+  ret.reserve(prgs.size());
+
+  for (const auto *prg : prgs)
+  {
+    assert(prg);
+    ret.push_back(operator()(*prg));
+  }
+
+  return ret;
+}
+
+///
+/// Starts the evaluation of an individual.
+///
+/// \param[in] prg individual to be evaluated
+/// \return        the (future) fitness of `prg`
+///
+/// Evaluators calling out to slow external resources (a simulator, a remote
+/// service...) can return immediately and complete the evaluation in the
+/// background: `evolution` keeps `env.evaluations_in_flight` evaluations
+/// going on at the same time (see also `evaluator_pool`).
+///
+/// \note
+/// The default implementation is synchronous: the evaluation takes place
+/// when the result is requested.
+///
+template<class T>
+std::future<fitness_t> evaluator<T>::async(const T &prg)
+{
+  return std::async(std::launch::deferred,
+                    [this, prg] { return operator()(prg); });
+}
+
 ///
 /// An approximate, faster version of the standard evaluator.
 ///
@@ -81,6 +132,209 @@ std::unique_ptr<basic_lambda_f> evaluator<T>::lambdify(const T &) const
   return nullptr;
 }
 
+///
+/// \return counters describing the work done so far
+///
+/// Counters are cumulative (they aren't reset by `clear()`).
+///
+/// \note The default implementation returns all zeros.
+///
+template<class T>
+perf_counters evaluator<T>::counters() const
+{
+  return {};
+}
+
+///
+/// Shares the evaluations with other processes working on the same task.
+///
+/// \param[in] dir directory containing the shared data
+/// \param[in] key identifies the data / parameters the fitness depends on
+/// \return        `true` if the evaluations are shared
+///
+/// \note The default implementation doesn't share anything.
+///
+/// \see shared_cache
+///
+template<class T>
+bool evaluator<T>::share(const std::filesystem::path &, const hash_t &)
+{
+  return false;
+}
+
+///
+/// \param[in] eva the real evaluator
+///
+template<class T>
+metered_evaluator<T>::metered_evaluator(evaluator<T> &eva)
+  : eva_(eva), requests_(0), elapsed_(0)
+{
+}
+
+///
+/// \param[in] prg a program (individual/team)
+/// \return        the fitness of `prg` (as calculated by the real evaluator)
+///
+template<class T>
+fitness_t metered_evaluator<T>::operator()(const T &prg)
+{
+  if (collected_ && collected_->first == prg.signature())
+    return collected_->second;
+
+  VITA_TRACE_SCOPE("evaluation");
+
+  const auto start(std::chrono::steady_clock::now());
+  auto ret(eva_(prg));
+  elapsed_ += std::chrono::steady_clock::now() - start;
+
+  ++requests_;
+  return ret;
+}
+
+///
+/// \param[in] prgs programs (individuals/teams)
+/// \return         the fitnesses of `prgs` (same order)
+///
+template<class T>
+std::vector<fitness_t> metered_evaluator<T>::batch(
+  const std::vector<const T *> &prgs)
+{
+  VITA_TRACE_SCOPE("batch evaluation");
+
+  const auto start(std::chrono::steady_clock::now());
+  auto ret(eva_.batch(prgs));
+  elapsed_ += std::chrono::steady_clock::now() - start;
+
+  requests_ += prgs.size();
+  return ret;
+}
+
+///
+/// \param[in] prg a program (individual/team)
+/// \return        the future fitness of `prg`
+///
+/// \see collect
+///
+template<class T>
+std::future<fitness_t> metered_evaluator<T>::async(const T &prg)
+{
+  ++requests_;
+  return eva_.async(prg);
+}
+
+///
+/// Waits for the result of an asynchronous evaluation.
+///
+/// \param[in] prg    a program whose evaluation has been started via `async`
+/// \param[in] result the future fitness of `prg`
+/// \return           the fitness of `prg`
+///
+/// The waiting time is accounted as evaluation time. The result is
+/// remembered until `forget()` is called: requests for the fitness of `prg`
+/// (usually by the replacement strategy) don't require another evaluation.
+///
+template<class T>
+fitness_t metered_evaluator<T>::collect(const T &prg,
+                                        std::future<fitness_t> &result)
+{
+  VITA_TRACE_SCOPE("evaluation");
+
+  const auto start(std::chrono::steady_clock::now());
+  collected_.emplace(prg.signature(), result.get());
+  elapsed_ += std::chrono::steady_clock::now() - start;
+
+  return collected_->second;
+}
+
+///
+/// Drops the result remembered by the last `collect()`.
+///
+/// \remark
+/// Required when the remembered value could become stale (e.g. the training
+/// data are going to change).
+///
+template<class T>
+void metered_evaluator<T>::forget()
+{
+  collected_.reset();
+}
+
+///
+/// \param[in] prg a program (individual/team)
+/// \return        an approximation of the fitness of `prg`
+///
+template<class T>
+fitness_t metered_evaluator<T>::fast(const T &prg)
+{
+  VITA_TRACE_SCOPE("fast evaluation");
+
+  const auto start(std::chrono::steady_clock::now());
+  auto ret(eva_.fast(prg));
+  elapsed_ += std::chrono::steady_clock::now() - start;
+
+  ++requests_;
+  return ret;
+}
+
+template<class T>
+bool metered_evaluator<T>::load(std::istream &in)
+{
+  return eva_.load(in);
+}
+
+template<class T>
+bool metered_evaluator<T>::save(std::ostream &out) const
+{
+  return eva_.save(out);
+}
+
+template<class T>
+void metered_evaluator<T>::clear()
+{
+  collected_.reset();
+  eva_.clear();
+}
+
+template<class T>
+std::string metered_evaluator<T>::info() const
+{
+  return eva_.info();
+}
+
+template<class T>
+std::unique_ptr<basic_lambda_f> metered_evaluator<T>::lambdify(
+  const T &prg) const
+{
+  return eva_.lambdify(prg);
+}
+
+template<class T>
+bool metered_evaluator<T>::share(const std::filesystem::path &dir,
+                                 const hash_t &key)
+{
+  return eva_.share(dir, key);
+}
+
+///
+/// \return the counters of the real evaluator plus number and duration of
+///         the requests
+///
+/// Evaluations are counted by the caching evaluators (see
+/// `evaluator_proxy`). Without a cache every request is an evaluation.
+///
+template<class T>
+perf_counters metered_evaluator<T>::counters() const
+{
+  auto ret(eva_.counters());
+
+  ret.requests = requests_;
+  if (!ret.cache_probes)
+    ret.evaluations = requests_;
+  ret.evaluation = elapsed_;
+
+  return ret;
+}
+
 template<class T>
 test_evaluator<T>::test_evaluator(test_evaluator_type et) : buffer_(), et_(et)
 {
@@ -0,0 +1,102 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_EVALUATOR_POOL_H)
+#define      VITA_EVALUATOR_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "kernel/evaluator.h"
+#include "kernel/random.h"
+
+namespace vita
+{
+///
+/// Runs many evaluations at the same time using a pool of evaluators.
+///
+/// \tparam T the type of individual used
+/// \tparam E the type of the real evaluators
+///
+/// Every evaluator of the pool is driven by its own worker thread and
+/// evaluates one individual at a time. This is meant for expensive external
+/// evaluations (e.g. every evaluator controls a simulator process or a
+/// remote service): workers mostly wait and the pool keeps the external
+/// resources busy.
+///
+/// Requests are served in FIFO order by the first available worker.
+///
+/// \remark
+/// Evaluators must be interchangeable (the same individual gets the same
+/// fitness from every evaluator of the pool).
+///
+template<class T, class E>
+class evaluator_pool : public evaluator<T>
+{
+public:
+  explicit evaluator_pool(std::vector<E>);
+
+  fitness_t operator()(const T &) override;
+  std::vector<fitness_t> batch(const std::vector<const T *> &) override;
+  std::future<fitness_t> async(const T &) override;
+  fitness_t fast(const T &) override;
+
+  void clear() override;
+
+  std::unique_ptr<basic_lambda_f> lambdify(const T &) const override;
+  perf_counters counters() const override;
+
+  /// \return number of evaluators of the pool
+  std::size_t size() const { return workers_->evaluators.size(); }
+
+private:
+  struct job
+  {
+    T prg;
+    bool fast;
+    std::promise<fitness_t> result;
+  };
+
+  // The shared state lives on the heap: worker threads refer to it and the
+  // pool remains movable.
+  struct workers
+  {
+    explicit workers(std::vector<E>);
+    ~workers();
+
+    void work(std::size_t);
+    void wait_idle();
+
+    std::vector<E> evaluators;
+    std::vector<std::thread> threads;
+
+    std::deque<job> jobs;
+    unsigned busy = 0;
+    bool stop = false;
+
+    std::mutex mutex;
+    std::condition_variable ready;  // new job or stop request
+    std::condition_variable idle;   // a worker completed its job
+  };
+
+  std::future<fitness_t> submit(const T &, bool);
+
+  std::unique_ptr<workers> workers_;
+};
+
+#include "kernel/evaluator_pool.tcc"
+}  // namespace vita
+
+#endif  // include guard
@@ -0,0 +1,231 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_EVALUATOR_POOL_H)
+#  error "Don't include this file directly, include the specific .h instead"
+#endif
+
+#if !defined(VITA_EVALUATOR_POOL_TCC)
+#define      VITA_EVALUATOR_POOL_TCC
+
+///
+/// \param[in] eva the evaluators of the pool (one worker thread for each
+///                evaluator)
+///
+template<class T, class E>
+evaluator_pool<T, E>::evaluator_pool(std::vector<E> eva)
+  : workers_(std::make_unique<workers>(std::move(eva)))
+{
+}
+
+template<class T, class E>
+evaluator_pool<T, E>::workers::workers(std::vector<E> eva)
+  : evaluators(std::move(eva))
+{
+  Expects(!evaluators.empty());
+
+  // Every worker gets its own substream of a master seed drawn from (a copy
+  // of) the engine of the calling thread: evaluators using random numbers
+  // are reproducible and the sequence of the caller isn't altered.
+  auto e(random::engine);
+  const auto master(static_cast<unsigned>(e()));
+
+  for (std::size_t i(0); i < evaluators.size(); ++i)
+    threads.emplace_back([this, master, i]
+                         {
+                           random::seed(master, static_cast<unsigned>(i));
+                           work(i);
+                         });
+}
+
+///
+/// Stops the workers (pending jobs are completed first).
+///
+template<class T, class E>
+evaluator_pool<T, E>::workers::~workers()
+{
+  {
+    std::lock_guard lock(mutex);
+    stop = true;
+  }
+  ready.notify_all();
+
+  for (auto &t : threads)
+    t.join();
+}
+
+///
+/// Main loop of a worker thread.
+///
+/// \param[in] i index of the evaluator used by the worker
+///
+template<class T, class E>
+void evaluator_pool<T, E>::workers::work(std::size_t i)
+{
+  for (;;)
+  {
+    std::unique_lock lock(mutex);
+    ready.wait(lock, [this] { return stop || !jobs.empty(); });
+    if (jobs.empty())
+      return;  // stop request
+
+    job j(std::move(jobs.front()));
+    jobs.pop_front();
+    ++busy;
+    lock.unlock();
+
+    try
+    {
+      j.result.set_value(j.fast ? evaluators[i].fast(j.prg)
+                                : evaluators[i](j.prg));
+    }
+    catch (...)
+    {
+      j.result.set_exception(std::current_exception());
+    }
+
+    lock.lock();
+    --busy;
+    lock.unlock();
+    idle.notify_all();
+  }
+}
+
+///
+/// Waits until every submitted job is completed.
+///
+template<class T, class E>
+void evaluator_pool<T, E>::workers::wait_idle()
+{
+  std::unique_lock lock(mutex);
+  idle.wait(lock, [this] { return jobs.empty() && !busy; });
+}
+
+template<class T, class E>
+std::future<fitness_t> evaluator_pool<T, E>::submit(const T &prg, bool fast)
+{
+  std::future<fitness_t> ret;
+
+  {
+    std::lock_guard lock(workers_->mutex);
+    workers_->jobs.push_back({prg, fast, {}});
+    ret = workers_->jobs.back().result.get_future();
+  }
+  workers_->ready.notify_one();
+
+  return ret;
+}
+
+///
+/// \param[in] prg the program (individual/team) to be evaluated
+/// \return        the future fitness of `prg`
+///
+/// The request is queued and the function returns immediately. Exceptions
+/// thrown by the evaluator are rethrown by `std::future::get()`.
+///
+template<class T, class E>
+std::future<fitness_t> evaluator_pool<T, E>::async(const T &prg)
+{
+  return submit(prg, false);
+}
+
+///
+/// \param[in] prg the program (individual/team) to be evaluated
+/// \return        the fitness of `prg`
+///
+template<class T, class E>
+fitness_t evaluator_pool<T, E>::operator()(const T &prg)
+{
+  return async(prg).get();
+}
+
+///
+/// \param[in] prgs the programs (individuals/teams) to be evaluated
+/// \return         the fitnesses of `prgs` (same order)
+///
+/// The programs are evaluated concurrently.
+///
+template<class T, class E>
+std::vector<fitness_t> evaluator_pool<T, E>::batch(
+  const std::vector<const T *> &prgs)
+{
+  std::vector<std::future<fitness_t>> pending;
+  pending.reserve(prgs.size());
+  for (const auto *p : prgs)
+    pending.push_back(async(*p));
+
+  std::vector<fitness_t> ret;
+  ret.reserve(prgs.size());
+  for (auto &f : pending)
+    ret.push_back(f.get());
+
+  return ret;
+}
+
+///
+/// \param[in] prg the program (individual/team) to be evaluated
+/// \return        an approximation of the fitness of `prg`
+///
+template<class T, class E>
+fitness_t evaluator_pool<T, E>::fast(const T &prg)
+{
+  return submit(prg, true).get();
+}
+
+///
+/// Clears the cached values of every evaluator of the pool.
+///
+/// Waits for the completion of the pending jobs.
+///
+template<class T, class E>
+void evaluator_pool<T, E>::clear()
+{
+  workers_->wait_idle();
+
+  for (auto &e : workers_->evaluators)
+    e.clear();
+}
+
+///
+/// \param[in] prg a program (individual/team)
+/// \return        a pointer to the executable version of `prg`
+///
+/// Waits for the completion of the pending jobs (the first evaluator could
+/// be in use by its worker).
+///
+template<class T, class E>
+std::unique_ptr<basic_lambda_f> evaluator_pool<T, E>::lambdify(
+  const T &prg) const
+{
+  workers_->wait_idle();
+
+  return workers_->evaluators.front().lambdify(prg);
+}
+
+///
+/// \return the sum of the counters of the evaluators of the pool
+///
+/// Waits for the completion of the pending jobs.
+///
+template<class T, class E>
+perf_counters evaluator_pool<T, E>::counters() const
+{
+  workers_->wait_idle();
+
+  perf_counters ret;
+  for (const auto &e : workers_->evaluators)
+    ret += e.counters();
+
+  return ret;
+}
+
+#endif  // include guard
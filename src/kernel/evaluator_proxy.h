@@ -13,8 +13,12 @@
 #if !defined(VITA_EVALUATOR_PROXY_H)
 #define      VITA_EVALUATOR_PROXY_H
 
+#include <algorithm>
+#include <typeinfo>
+
 #include "kernel/cache.h"
 #include "kernel/evaluator.h"
+#include "kernel/shared_cache.h"
 
 namespace vita
 {
@@ -24,7 +28,8 @@ namespace vita
 /// \tparam T the type of individual used
 ///
 /// evaluator_proxy uses an ad-hoc internal hash table to cache fitness scores
-/// of individuals.
+/// of individuals. The cache can be backed by a second level shared with
+/// other processes (see `share()`).
 ///
 template<class T, class E>
 class evaluator_proxy : public evaluator<T>
@@ -39,11 +44,15 @@ public:
   void clear() override;
 
   fitness_t operator()(const T &) override;
+  std::vector<fitness_t> batch(const std::vector<const T *> &) override;
+  std::future<fitness_t> async(const T &) override;
   fitness_t fast(const T &) override;
 
   std::string info() const override;
 
   std::unique_ptr<basic_lambda_f> lambdify(const T &) const override;
+  perf_counters counters() const override;
+  bool share(const std::filesystem::path &, const hash_t &) override;
 
 private:
   // Access to the real evaluator.
@@ -51,6 +60,17 @@ private:
 
   // Hash table cache.
   cache cache_;
+  unsigned bits_;
+
+  // Second level cache shared with other processes (possibly detached).
+  shared_cache shared_;
+  std::uintmax_t shared_hits_ = 0;
+
+  // Cumulative cache statistics (not reset by `clear()`).
+  std::uintmax_t evaluations_ = 0;  // requests forwarded to `eva_`
+  std::uintmax_t probes_ = 0;
+  std::uintmax_t hits_ = 0;
+  std::uintmax_t evictions_ = 0;
 };
 
 #include "kernel/evaluator_proxy.tcc"
@@ -23,7 +23,7 @@
 ///
 template<class T, class E>
 evaluator_proxy<T, E>::evaluator_proxy(E eva, unsigned ts)
-  : eva_(std::move(eva)), cache_(ts)
+  : eva_(std::move(eva)), cache_(ts), bits_(ts)
 {
   Expects(ts > 6);
 }
@@ -36,10 +36,12 @@ template<class T, class E>
 fitness_t evaluator_proxy<T, E>::operator()(const T &prg)
 {
   fitness_t f(cache_.find(prg.signature()));
+  ++probes_;
 
   if (f.size())
   {
     assert(cache_.hits());
+    ++hits_;
 
     // Hash collision checking code can slow down the program very much.
 #if !defined(NDEBUG)
@@ -66,9 +68,22 @@ fitness_t evaluator_proxy<T, E>::operator()(const T &prg)
   }
   else  // not found in cache
   {
-    f = eva_(prg);
+    f = shared_.find(prg.signature());
 
-    cache_.insert(prg.signature(), f);
+    if (f.size())  // evaluated by another process
+    {
+      ++hits_;
+      ++shared_hits_;
+    }
+    else
+    {
+      f = eva_(prg);
+      ++evaluations_;
+      shared_.insert(prg.signature(), f);
+    }
+
+    if (cache_.insert(prg.signature(), f))
+      ++evictions_;
 
 #if !defined(NDEBUG)
     fitness_t f1(cache_.find(prg.signature()));
@@ -80,6 +95,138 @@ fitness_t evaluator_proxy<T, E>::operator()(const T &prg)
   return f;
 }
 
+///
+/// \param[in] prgs the programs (individuals/teams) whose fitness we want to
+///                 know
+/// \return         the fitnesses of `prgs` (same order)
+///
+/// Fitnesses are taken from the caches when possible. The remaining programs
+/// are deduplicated (by signature) and forwarded, as a single batch, to the
+/// real evaluator.
+///
+template<class T, class E>
+std::vector<fitness_t> evaluator_proxy<T, E>::batch(
+  const std::vector<const T *> &prgs)
+{
+  std::vector<fitness_t> ret(prgs.size());
+
+  // Programs not found in cache: signature / position in `prgs`.
+  std::vector<std::pair<hash_t, std::size_t>> miss;
+
+  for (std::size_t i(0); i < prgs.size(); ++i)
+  {
+    const auto sig(prgs[i]->signature());
+
+    if (const auto &f = cache_.find(sig); f.size())
+      ret[i] = f;
+    else if (auto sf = shared_.find(sig); sf.size())
+    {
+      ++shared_hits_;
+      if (cache_.insert(sig, sf))
+        ++evictions_;
+      ret[i] = std::move(sf);
+    }
+    else
+      miss.emplace_back(sig, i);
+  }
+
+  probes_ += prgs.size();
+  hits_ += prgs.size() - miss.size();
+
+  if (miss.empty())
+    return ret;
+
+  const auto less([](const auto &a, const auto &b)
+                  {
+                    return a.first.data[0] < b.first.data[0]
+                           || (a.first.data[0] == b.first.data[0]
+                               && a.first.data[1] < b.first.data[1]);
+                  });
+  std::sort(miss.begin(), miss.end(), less);
+
+  std::vector<const T *> unique;
+  for (std::size_t j(0); j < miss.size(); ++j)
+    if (j == 0 || miss[j].first != miss[j - 1].first)
+      unique.push_back(prgs[miss[j].second]);
+
+  const auto fs(eva_.batch(unique));
+  assert(fs.size() == unique.size());
+  evaluations_ += unique.size();
+
+  for (std::size_t j(0), u(0); j < miss.size(); ++j)
+  {
+    if (j && miss[j].first != miss[j - 1].first)
+      ++u;
+
+    ret[miss[j].second] = fs[u];
+  }
+
+  for (std::size_t u(0); u < unique.size(); ++u)
+  {
+    const auto sig(unique[u]->signature());
+
+    if (cache_.insert(sig, fs[u]))
+      ++evictions_;
+    shared_.insert(sig, fs[u]);
+  }
+
+  return ret;
+}
+
+///
+/// \param[in] prg the program (individual/team) whose fitness we want to know
+/// \return        the future fitness of `prg`
+///
+/// Cached fitnesses are immediately available. Otherwise the evaluation is
+/// started via the real evaluator and the result is cached when it's
+/// collected.
+///
+/// \warning
+/// The caches aren't thread safe: the returned future must be waited for in
+/// the thread using the proxy.
+///
+template<class T, class E>
+std::future<fitness_t> evaluator_proxy<T, E>::async(const T &prg)
+{
+  const auto sig(prg.signature());
+  ++probes_;
+
+  fitness_t f(cache_.find(sig));
+  if (!f.size())
+  {
+    f = shared_.find(sig);
+
+    if (f.size())
+    {
+      ++shared_hits_;
+      if (cache_.insert(sig, f))
+        ++evictions_;
+    }
+  }
+
+  if (f.size())
+  {
+    ++hits_;
+
+    std::promise<fitness_t> ready;
+    ready.set_value(f);
+    return ready.get_future();
+  }
+
+  ++evaluations_;
+  return std::async(std::launch::deferred,
+                    [this, sig, result = eva_.async(prg)]() mutable
+                    {
+                      const auto ret(result.get());
+
+                      if (cache_.insert(sig, ret))
+                        ++evictions_;
+                      shared_.insert(sig, ret);
+
+                      return ret;
+                    });
+}
+
 ///
 /// \param[in] prg the program (individual/team) whose fitness we want to know
 /// \return        an approximation of the fitness of `prg`
@@ -118,10 +265,20 @@ bool evaluator_proxy<T, E>::save(std::ostream &out) const
 ///
 /// Resets the evaluation cache.
 ///
+/// \remark
+/// Also the cached values of the real evaluator (if any) are cleared.
+///
+/// \remark
+/// The shared cache is detached: clearing is required when the data change
+/// (e.g. DSS) and the shared values are no longer valid. The caller can
+/// re-attach it (`share()`) with a key matching the new data.
+///
 template<class T, class E>
 void evaluator_proxy<T, E>::clear()
 {
   cache_.clear();
+  shared_.detach();
+  eva_.clear();
 }
 
 ///
@@ -136,7 +293,49 @@ std::string evaluator_proxy<T, E>::info() const
   return
     "hits " + std::to_string(hits) +
     ", probes " + std::to_string(probes) +
-    (probes ? " (ratio " + std::to_string(hits * 100 / probes) + "%)" : "");
+    (probes ? " (ratio " + std::to_string(hits * 100 / probes) + "%)" : "") +
+    (shared_hits_ ? ", shared hits " + std::to_string(shared_hits_) : "");
+}
+
+///
+/// \return counters of the real evaluator plus cache statistics and number
+///         of evaluations (requests not served by the caches)
+///
+template<class T, class E>
+perf_counters evaluator_proxy<T, E>::counters() const
+{
+  auto ret(eva_.counters());
+
+  ret.evaluations += evaluations_;
+  ret.cache_probes += probes_;
+  ret.cache_hits += hits_;
+  ret.cache_evictions += evictions_;
+
+  return ret;
+}
+
+///
+/// Attaches a second level cache shared with other processes.
+///
+/// \param[in] dir directory containing the shared cache files
+/// \param[in] key identifies the data / parameters the fitness depends on
+/// \return        `true` if the shared cache is available
+///
+/// The type of the real evaluator is combined with `key`: distinct
+/// evaluators never share their values.
+///
+/// \see shared_cache
+///
+template<class T, class E>
+bool evaluator_proxy<T, E>::share(const std::filesystem::path &dir,
+                                  const hash_t &key)
+{
+  const std::string type(typeid(E).name());
+
+  auto k(murmurhash3::hash128(type.data(), type.size()));
+  k.combine(key);
+
+  return shared_.attach(dir, static_cast<std::uint8_t>(bits_), k);
 }
 
 ///
@@ -15,12 +15,18 @@
 
 #include <algorithm>
 #include <csignal>
+#include <deque>
+#include <future>
 
 #include "kernel/evaluator_proxy.h"
 #include "kernel/evolution_strategy.h"
 #include "kernel/evolution_summary.h"
+#include "kernel/migration.h"
 #include "kernel/population.h"
+#include "kernel/population_log.h"
+#include "utility/async_writer.h"
 #include "utility/timer.h"
+#include "utility/trace.h"
 
 namespace vita
 {
@@ -51,20 +57,54 @@ public:
 
   bool debug() const;
 
+  // Serialization (state of a run in progress).
+  bool load(std::istream &);
+  bool save(std::ostream &) const;
+
 private:
   // *** Support methods ***
-  analyzer<T> get_stats() const;
-  void log_evolution(unsigned) const;
+  analyzer<T> get_stats();
+  void log_evolution(unsigned);
+  void migrate();
   void print_progress(unsigned, unsigned, bool, timer *) const;
   bool stop_condition(const summary<T> &) const;
+  void update_perf(const perf_counters &);
 
   // *** Data members ***
   population<T> pop_;
-  evaluator<T> &eva_;
+  metered_evaluator<T> eva_;  // forwards to the user-supplied evaluator
   summary<T>  stats_;
   ES<T>          es_;
 
   after_generation_callback_t after_generation_callback_;
+
+  // `true` when `run()` has to continue a previously saved evolution.
+  bool resume_;
+
+  // *** Incremental statistics ***
+  // What `get_stats()` knows about an individual of the population. Records
+  // are parallel to the population; the replacement strategy reports the
+  // slots it's going to write (see `changed()`) and only those records are
+  // refreshed.
+  struct stats_record
+  {
+    fitness_t fit;
+    unsigned  length = 0;
+    bool      valid = false;  // symbols of the individual are in `az_`
+  };
+
+  void changed(const typename population<T>::coord &);
+
+  std::vector<std::vector<stats_record>> records_;
+  std::vector<typename population<T>::coord> dirty_;
+  std::uintmax_t revision_ = 0;  // `pop_.revision()` matching `records_`
+  analyzer<T> az_;
+
+  // Log files are written by a background thread.
+  async_writer writer_;
+
+  // Connection to the other islands (see `environment::migration`).
+  migration_link link_;
 };
 
 #include "kernel/evolution.tcc"
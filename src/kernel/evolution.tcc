@@ -77,9 +77,12 @@ inline void set()
 ///
 template<class T, template<class> class ES>
 evolution<T, ES>::evolution(const problem &p, evaluator<T> &eva)
-  : pop_(p), eva_(eva), es_(pop_, eva_, &stats_), after_generation_callback_()
+  : pop_(p), eva_(eva), es_(pop_, eva_, &stats_), after_generation_callback_(),
+    resume_(false)
 {
   Expects(p.debug());
+
+  es_.replacement.observe([this](const auto &c) { changed(c); });
   Ensures(debug());
 }
 
@@ -118,18 +121,108 @@ bool evolution<T, ES>::stop_condition(const summary<T> &s) const
   return es_.stop_condition();
 }
 
+///
+/// Takes note of a slot of the population that is going to be written.
+///
+/// \param[in] c coordinates of the slot (possibly one past the end of its
+///              layer for an appended individual)
+///
+/// The symbols of the current individual are removed from the statistics
+/// (it's still in place) and the slot is refreshed by the next call of
+/// `get_stats()`.
+///
+template<class T, template<class> class ES>
+void evolution<T, ES>::changed(const typename population<T>::coord &c)
+{
+  // A full scan is pending: nothing to do.
+  if (records_.empty() || revision_ != pop_.revision())
+    return;
+
+  auto &layer(records_[c.layer]);
+  if (c.index >= layer.size())
+  {
+    layer.resize(c.index + 1);
+    dirty_.push_back(c);
+    return;
+  }
+
+  if (auto &r(layer[c.index]); r.valid)
+  {
+    az_.remove_symbols(pop_[c]);
+    r.valid = false;
+    dirty_.push_back(c);
+  }
+}
+
 ///
 /// \return statistical information about the population
 ///
+/// Statistics are updated incrementally: only the slots written since the
+/// previous call (see `changed()`) are evaluated and scanned for symbols.
+/// The distributions are refilled from the cached values (ages change every
+/// generation).
+///
+/// A change of the layout of the population (e.g. ALPS adding / resetting a
+/// layer, a migration) requires a full scan.
+///
+/// \remark
+/// Cached fitnesses refer to the current dataset: `records_` must be cleared
+/// when the dataset changes (see `run()`).
+///
 template<class T, template<class> class ES>
-analyzer<T> evolution<T, ES>::get_stats() const
+analyzer<T> evolution<T, ES>::get_stats()
 {
-  analyzer<T> az;
+  using coord = typename population<T>::coord;
+  const auto layers(pop_.layers());
+
+  if (records_.empty() || revision_ != pop_.revision())
+  {
+    az_.clear();
+    dirty_.clear();
+
+    records_.assign(layers, {});
+    for (unsigned l(0); l < layers; ++l)
+    {
+      records_[l].resize(pop_.individuals(l));
+
+      for (unsigned i(0); i < pop_.individuals(l); ++i)
+        dirty_.push_back(coord{l, i});
+    }
+
+    revision_ = pop_.revision();
+  }
+
+  std::vector<const T *> prgs;
+  prgs.reserve(dirty_.size());
+  for (const auto &c : dirty_)
+    prgs.push_back(&pop_[c]);
+
+  const auto fs(eva_.batch(prgs));
+
+  for (std::size_t k(0); k < dirty_.size(); ++k)
+  {
+    auto &r(records_[dirty_[k].layer][dirty_[k].index]);
+    assert(!r.valid);
+
+    r.length = az_.add_symbols(*prgs[k]);
+    r.fit = fs[k];
+    r.valid = true;
+  }
+  dirty_.clear();
+
+  az_.clear_values();
+  for (unsigned l(0); l < layers; ++l)
+  {
+    assert(records_[l].size() == pop_.individuals(l));
 
-  for (auto it(pop_.begin()), end(pop_.end()); it != end; ++it)
-    az.add(*it, eva_(*it), it.layer());
+    for (unsigned i(0); i < records_[l].size(); ++i)
+    {
+      const auto &r(records_[l][i]);
+      az_.add_values(pop_[{l, i}].age(), r.fit, r.length, l);
+    }
+  }
 
-  return az;
+  return az_;
 }
 
 ///
@@ -154,8 +247,13 @@ analyzer<T> evolution<T, ES>::get_stats() const
 /// CSV-like file. Note also that it's simple to extract and plot data with
 /// GNU Plot.
 ///
+/// Lines are formatted here but written by a background thread (see
+/// `async_writer`) which keeps the files open for the whole run. The
+/// population log can also be saved in a compact binary format
+/// (`env.stat.binary_population`).
+///
 template<class T, template<class> class ES>
-void evolution<T, ES>::log_evolution(unsigned run_count) const
+void evolution<T, ES>::log_evolution(unsigned run_count)
 {
   static unsigned last_run(0);
 
@@ -168,70 +266,149 @@ void evolution<T, ES>::log_evolution(unsigned run_count) const
 
   if (!env.stat.dynamic_file.empty())
   {
-    std::ofstream f_dyn(fullpath(env.stat.dynamic_file), std::ios_base::app);
-    if (f_dyn.good())
-    {
-      if (last_run != run_count)
-        f_dyn << "\n\n";
+    std::ostringstream f_dyn;
 
-      f_dyn << run_count << ' ' << stats_.gen;
+    if (last_run != run_count)
+      f_dyn << "\n\n";
 
-      if (stats_.best.solution.empty())
-        f_dyn << " ?";
-      else
-        f_dyn << ' ' << stats_.best.score.fitness[0];
-
-      f_dyn << ' ' << stats_.az.fit_dist().mean()[0]
-            << ' ' << stats_.az.fit_dist().standard_deviation()[0]
-            << ' ' << stats_.az.fit_dist().entropy()
-            << ' ' << stats_.az.fit_dist().min()[0]
-            << ' ' << static_cast<unsigned>(stats_.az.length_dist().mean())
-            << ' ' << stats_.az.length_dist().standard_deviation()
-            << ' ' << static_cast<unsigned>(stats_.az.length_dist().max())
-            << ' ' << stats_.mutations
-            << ' ' << stats_.crossovers
-            << ' ' << stats_.az.functions(0)
-            << ' ' << stats_.az.terminals(0)
-            << ' ' << stats_.az.functions(1)
-            << ' ' << stats_.az.terminals(1);
-
-      for (unsigned active(0); active <= 1; ++active)
-        for (const auto &symb_stat : stats_.az)
-          f_dyn << ' ' << symb_stat.first->name()
-                << ' ' << symb_stat.second.counter[active];
-
-      f_dyn << " \"";
-      if (!stats_.best.solution.empty())
-        f_dyn << out::in_line << stats_.best.solution;
-      f_dyn << "\"\n";
-    }
+    f_dyn << run_count << ' ' << stats_.gen;
+
+    if (stats_.best.solution.empty())
+      f_dyn << " ?";
+    else
+      f_dyn << ' ' << stats_.best.score.fitness[0];
+
+    f_dyn << ' ' << stats_.az.fit_dist().mean()[0]
+          << ' ' << stats_.az.fit_dist().standard_deviation()[0]
+          << ' ' << stats_.az.fit_dist().entropy()
+          << ' ' << stats_.az.fit_dist().min()[0]
+          << ' ' << static_cast<unsigned>(stats_.az.length_dist().mean())
+          << ' ' << stats_.az.length_dist().standard_deviation()
+          << ' ' << static_cast<unsigned>(stats_.az.length_dist().max())
+          << ' ' << stats_.mutations
+          << ' ' << stats_.crossovers
+          << ' ' << stats_.az.functions(0)
+          << ' ' << stats_.az.terminals(0)
+          << ' ' << stats_.az.functions(1)
+          << ' ' << stats_.az.terminals(1);
+
+    for (unsigned active(0); active <= 1; ++active)
+      for (const auto &symb_stat : stats_.az)
+        f_dyn << ' ' << symb_stat.first->name()
+              << ' ' << symb_stat.second.counter[active];
+
+    f_dyn << " \"";
+    if (!stats_.best.solution.empty())
+      f_dyn << out::in_line << stats_.best.solution;
+    f_dyn << "\"\n";
+
+    writer_.write(fullpath(env.stat.dynamic_file), f_dyn.str());
   }
 
   if (!env.stat.population_file.empty())
   {
-    std::ofstream f_pop(fullpath(env.stat.population_file),
-                        std::ios_base::app);
-    if (f_pop.good())
+    std::string f_pop;
+
+    if (env.stat.binary_population)
+      for (const auto &f : stats_.az.fit_dist().seen())
+        // f.first: value, f.second: frequency
+        population_log::append_binary(f_pop, run_count, stats_.gen,
+                                      f.first[0], f.second);
+    else
     {
       if (last_run != run_count)
-        f_pop << "\n\n";
+        f_pop = "\n\n";
 
       for (const auto &f : stats_.az.fit_dist().seen())
-        // f.first: value, f.second: frequency
-        f_pop << run_count << ' ' << stats_.gen << ' '
-              << std::fixed << std::scientific
-              << std::setprecision(
-                   std::numeric_limits<fitness_t::value_type>::digits10 + 2)
-              << f.first[0] << ' ' << f.second << '\n';
+        population_log::append_text(f_pop, run_count, stats_.gen,
+                                    f.first[0], f.second);
     }
+
+    writer_.write(fullpath(env.stat.population_file), std::move(f_pop));
   }
 
-  es_.log_strategy(last_run, run_count);
+  es_.log_strategy(last_run, run_count, writer_);
 
   if (last_run != run_count)
     last_run = run_count;
 }
 
+///
+/// Exchanges individuals with the other islands.
+///
+/// The best `env.migration.migrants` individuals of the population are sent
+/// to the hub. The immigrants replace the worst individuals of the last layer
+/// (with ALPS the only layer accepting individuals of any age); the best
+/// individual of the layer is always preserved.
+///
+/// \warning
+/// Islands must share the same problem setup: symbols are identified by
+/// their opcodes.
+///
+template<class T, template<class> class ES>
+void evolution<T, ES>::migrate()
+{
+  VITA_TRACE_SCOPE("migration");
+
+  using coord = typename population<T>::coord;
+  const auto &prob(pop_.get_problem());
+
+  const auto better([](const auto &a, const auto &b)
+                    {
+                      return a.first > b.first;
+                    });
+
+  // --------- EMIGRANTS ---------
+  std::vector<std::pair<fitness_t, coord>> ranked;
+  for (unsigned l(0); l < pop_.layers(); ++l)
+    for (unsigned i(0); i < pop_.individuals(l); ++i)
+      ranked.emplace_back(eva_(pop_[{l, i}]), coord{l, i});
+
+  const auto n(std::min<std::size_t>(prob.env.migration.migrants,
+                                     ranked.size()));
+  std::partial_sort(ranked.begin(), ranked.begin() + n, ranked.end(),
+                    better);
+
+  std::ostringstream out;
+  for (std::size_t j(0); j < n; ++j)
+    pop_[ranked[j].second].save(out);
+
+  std::vector<std::string> packets;
+  if (!link_.exchange(out.str(), &packets))
+  {
+    vitaWARNING << "Migration hub unreachable: island is isolated";
+    return;
+  }
+
+  // --------- IMMIGRANTS ---------
+  const auto last(pop_.layers() - 1);
+
+  std::vector<std::pair<fitness_t, unsigned>> slots;
+  for (unsigned i(0); i < pop_.individuals(last); ++i)
+    slots.emplace_back(eva_(pop_[{last, i}]), i);
+  std::sort(slots.begin(), slots.end(), better);  // worst ones at the end
+
+  for (const auto &p : packets)
+  {
+    std::istringstream in(p);
+
+    for (T imm; slots.size() > 1 && imm.load(in, prob.sset);)
+    {
+      const auto f(eva_(imm));
+      if (f > stats_.best.score.fitness)
+      {
+        stats_.best.solution = imm;
+        stats_.best.score.fitness = f;
+      }
+
+      const coord c{last, slots.back().second};
+      changed(c);
+      pop_[c] = imm;
+      slots.pop_back();
+    }
+  }
+}
+
 ///
 /// Prints evolution information (if `log::reporting_level >= log::lOUTPUT`).
 ///
@@ -294,10 +471,22 @@ template<class T, template<class> class ES>
 template<class S>
 const summary<T> &evolution<T, ES>::run(unsigned run_count, S shake)
 {
-  stats_.clear();
-  stats_.best.solution = pop_[{0, 0}];
-  stats_.best.score.fitness = eva_(stats_.best.solution);
+  const bool resumed(std::exchange(resume_, false));
 
+  records_.clear();
+  az_.clear();
+
+  const auto perf_base(eva_.counters());
+  using clock = std::chrono::steady_clock;
+
+  if (!resumed)
+  {
+    stats_.clear();
+    stats_.best.solution = pop_[{0, 0}];
+    stats_.best.score.fitness = eva_(stats_.best.solution);
+  }
+
+  const auto elapsed_base(stats_.elapsed);
   timer measure;
   timer from_last_msg;
 
@@ -306,8 +495,60 @@ const summary<T> &evolution<T, ES>::run(unsigned run_count, S shake)
 
   es_.init();  // customizatin point for strategy-specific initialization
 
-  for (stats_.gen = 0; !stop_condition(stats_) && !stop;  ++stats_.gen)
+  const auto &migration(pop_.get_problem().env.migration);
+  if (!migration.coordinator.empty() && !link_.connected()
+      && !link_.connect(migration.coordinator))
+  {
+    vitaWARNING << "Cannot reach migration hub " << migration.coordinator
+                << ": island is isolated";
+  }
+
+  const auto replace([&, this](const auto &parents, const auto &off,
+                               unsigned k)
   {
+    const auto start(clock::now());
+    const auto before(stats_.best.score.fitness);
+    {
+      VITA_TRACE_SCOPE("replacement");
+      es_.replacement.run(parents, off, &stats_);
+    }
+    stats_.perf.replacement += clock::now() - start;
+
+    if (stats_.best.score.fitness != before)
+      print_progress(k, run_count, true, &from_last_msg);
+  });
+
+  // Offspring whose evaluation is going on (see `evaluations_in_flight`).
+  using parents_t = decltype(es_.selection.run());
+  using offspring_t = decltype(
+    es_.recombination.run(std::declval<const parents_t &>()));
+  struct pending
+  {
+    parents_t parents;
+    offspring_t off;
+    std::future<fitness_t> fitness;
+    unsigned k;
+  };
+  std::deque<pending> in_flight;
+  const auto max_in_flight(pop_.get_problem().env.evaluations_in_flight);
+
+  // Results are integrated in submission order (not in completion order):
+  // given the seed, the evolution doesn't depend on the evaluation times.
+  const auto integrate([&, this]
+  {
+    auto &p(in_flight.front());
+    eva_.collect(p.off[0], p.fitness);
+    replace(p.parents, p.off, p.k);
+    eva_.forget();
+    in_flight.pop_front();
+  });
+
+  for (stats_.gen = resumed ? stats_.gen + 1 : 0;
+       !stop_condition(stats_) && !stop;
+       ++stats_.gen)
+  {
+    VITA_TRACE_SCOPE("generation");
+
     if (shake(stats_.gen))
     {
       // The `shake` functions clear cached fitness values (they refer to the
@@ -316,11 +557,19 @@ const summary<T> &evolution<T, ES>::run(unsigned run_count, S shake)
       assert(!stats_.best.solution.empty());
       stats_.best.score.fitness = eva_(stats_.best.solution);
 
+      records_.clear();
+      az_.clear();
+
       print_progress(0, run_count, true, &from_last_msg);
     }
 
-    stats_.az = get_stats();
-    log_evolution(run_count);
+    auto t0(clock::now());
+    {
+      VITA_TRACE_SCOPE("statistics");
+      stats_.az = get_stats();
+      log_evolution(run_count);
+    }
+    stats_.perf.statistics += clock::now() - t0;
 
     for (unsigned k(0); k < pop_.individuals() && !stop; ++k)
     {
@@ -332,20 +581,46 @@ const summary<T> &evolution<T, ES>::run(unsigned run_count, S shake)
       }
 
       // --------- SELECTION ---------
-      auto parents(es_.selection.run());
+      t0 = clock::now();
+      auto parents([this]
+                   {
+                     VITA_TRACE_SCOPE("selection");
+                     return es_.selection.run();
+                   }());
+      auto t1(clock::now());
+      stats_.perf.selection += t1 - t0;
 
       // --------- CROSSOVER / MUTATION ---------
-      auto off(es_.recombination.run(parents));
+      auto off([&, this]
+               {
+                 VITA_TRACE_SCOPE("recombination");
+                 return es_.recombination.run(parents);
+               }());
+      t0 = clock::now();
+      stats_.perf.recombination += t0 - t1;
 
       // --------- REPLACEMENT --------
-      const auto before(stats_.best.score.fitness);
-      es_.replacement.run(parents, off, &stats_);
+      if (max_in_flight <= 1)
+        replace(parents, off, k);
+      else
+      {
+        auto fitness(eva_.async(off[0]));
+        in_flight.push_back({std::move(parents), std::move(off),
+                             std::move(fitness), k});
 
-      if (stats_.best.score.fitness != before)
-        print_progress(k, run_count, true, &from_last_msg);
+        if (in_flight.size() >= max_in_flight)
+          integrate();
+      }
     }
 
-    stats_.elapsed = measure.elapsed();
+    while (!in_flight.empty())
+      integrate();
+
+    if (link_.connected() && (stats_.gen + 1) % migration.interval == 0)
+      migrate();
+
+    stats_.elapsed = elapsed_base + measure.elapsed();
+    update_perf(perf_base);
 
     es_.after_generation();  // hook for strategy-specific bookkeeping
     if (after_generation_callback_)
@@ -356,10 +631,34 @@ const summary<T> &evolution<T, ES>::run(unsigned run_count, S shake)
            << std::chrono::duration<double>(stats_.elapsed).count()
            << "s" << std::string(10, ' ');
 
+  writer_.flush();  // log files are complete when `run` returns
+
   term::reset();
   return stats_;
 }
 
+///
+/// Refreshes the work counters of the summary.
+///
+/// \param[in] base counters of the evaluator at the beginning of the run
+///
+/// Evaluators' counters are cumulative: the summary reports the work done
+/// in the current run. Phase timers are updated directly by `run()`.
+///
+template<class T, template<class> class ES>
+void evolution<T, ES>::update_perf(const perf_counters &base)
+{
+  auto c(eva_.counters());
+  c -= base;
+
+  c.selection = stats_.perf.selection;
+  c.recombination = stats_.perf.recombination;
+  c.replacement = stats_.perf.replacement;
+  c.statistics = stats_.perf.statistics;
+
+  stats_.perf = c;
+}
+
 ///
 /// A shortcut to call the `run` method without a shake function.
 ///
@@ -369,6 +668,54 @@ const summary<T> &evolution<T, ES>::run(unsigned run_count)
   return run(run_count, [](unsigned) { return false; });
 }
 
+///
+/// Loads the state of a run in progress.
+///
+/// \param[in] in input stream
+/// \return       `true` if the object has been loaded correctly
+///
+/// The next call to `run()` continues the saved evolution (from the
+/// generation following the saved one) instead of starting a new one.
+///
+/// \note
+/// If the load operation isn't successful the current object isn't changed.
+///
+template<class T, template<class> class ES>
+bool evolution<T, ES>::load(std::istream &in)
+{
+  const auto &prob(pop_.get_problem());
+
+  auto t_pop(pop_);
+  if (!t_pop.load(in, prob))
+    return false;
+
+  summary<T> t_stats;
+  if (!t_stats.load(in, prob))
+    return false;
+
+  // `es_` refers to `pop_` and `stats_`: they're updated in place.
+  pop_ = t_pop;
+  stats_ = t_stats;
+  resume_ = true;
+
+  return true;
+}
+
+///
+/// Saves the state of a run in progress.
+///
+/// \param[out] out output stream
+/// \return         `true` if the object has been saved correctly
+///
+/// Meant to be called at the end of a generation (e.g. from the
+/// `after_generation` callback).
+///
+template<class T, template<class> class ES>
+bool evolution<T, ES>::save(std::ostream &out) const
+{
+  return pop_.save(out) && stats_.save(out);
+}
+
 ///
 /// \return `true` if object passes the internal consistency check
 ///
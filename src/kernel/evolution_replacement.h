@@ -13,7 +13,10 @@
 #if !defined(VITA_EVOLUTION_REPLACEMENT_H)
 #define      VITA_EVOLUTION_REPLACEMENT_H
 
+#include <functional>
+
 #include "kernel/alps.h"
+#include "utility/trace.h"
 
 namespace vita {
 namespace replacement {
@@ -26,6 +29,11 @@ namespace replacement {
 /// In the strategy design pattern, this class is the strategy interface and
 /// vita::evolution is the context.
 ///
+/// \remark
+/// Derived classes change the population only via `write()` / `append()`:
+/// this way the observer (see `evolution::get_stats()`) knows the slots to be
+/// updated.
+///
 /// \see
 /// - <http://en.wikipedia.org/wiki/Strategy_pattern>
 ///
@@ -33,14 +41,27 @@ template<class T>
 class strategy
 {
 public:
+  using coord = typename population<T>::coord;
   using offspring_t = typename recombination::strategy<T>::offspring_t;
   using parents_t = typename selection::strategy<T>::parents_t;
 
+  /// Function called before a slot of the population is written (the
+  /// previous individual, if any, is still in place).
+  using observer_t = std::function<void (const coord &)>;
+
   strategy(population<T> &, evaluator<T> &);
 
+  void observe(observer_t);
+
 protected:
+  void write(const coord &, const T &);
+  void append(unsigned, const T &);
+
   population<T> &pop_;
   evaluator<T>  &eva_;
+
+private:
+  observer_t observer_;
 };
 
 ///
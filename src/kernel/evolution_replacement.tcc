@@ -27,6 +27,50 @@ strategy<T>::strategy(population<T> &pop, evaluator<T> &eva) : pop_(pop),
 {
 }
 
+///
+/// Sets the function notified of the changes of the population.
+///
+/// \param[in] o observer (an empty function disables the notifications)
+///
+template<class T>
+void strategy<T>::observe(observer_t o)
+{
+  observer_ = std::move(o);
+}
+
+///
+/// Replaces an individual of the population.
+///
+/// \param[in] c   coordinates of the slot to be written
+/// \param[in] prg the new individual
+///
+template<class T>
+void strategy<T>::write(const coord &c, const T &prg)
+{
+  if (observer_)
+    observer_(c);
+
+  pop_[c] = prg;
+}
+
+///
+/// Adds an individual at the end of a layer (if the layer isn't full).
+///
+/// \param[in] l   a layer
+/// \param[in] prg the new individual
+///
+template<class T>
+void strategy<T>::append(unsigned l, const T &prg)
+{
+  if (pop_.individuals(l) < pop_.allowed(l))
+  {
+    if (observer_)
+      observer_({l, pop_.individuals(l)});
+
+    pop_.add_to_layer(l, prg);
+  }
+}
+
 ///
 /// \param[in] parent    coordinates of the parents (in the population).
 /// \param[in] offspring vector of the "children".
@@ -60,7 +104,7 @@ void family_competition<T>::run(
   if (elitism == trilean::yes)
   {
     if (fit_off > fit_parent[id_worst])
-      pop[parent[id_worst]] = offspring[0];
+      this->write(parent[id_worst], offspring[0]);
   }
   else  // !elitism
   {
@@ -72,14 +116,14 @@ void family_competition<T>::run(
     double replace(1.0 - (fit_off[0]
                           / (fit_off[0] + fit_parent[id_worst][0])));
     if (random::boolean(replace))
-      pop[parent[id_worst]] = offspring[0];
+      this->write(parent[id_worst], offspring[0]);
     else
     {
       //replace = 1.0 / (1.0 + exp(f_parent[!id_worst][0] - fit_off[0]));
       replace = 1.0 - (fit_off[0] / (fit_off[0] + fit_parent[!id_worst][0]));
 
       if (random::boolean(replace))
-        pop[parent[!id_worst]] = offspring[0];
+        this->write(parent[!id_worst], offspring[0]);
     }
   }
 
@@ -130,7 +174,7 @@ void tournament<T>::run(
   const bool replace(f_rep_idx < fit_off);
 
   if (elitism == trilean::no || replace)
-    pop[rep_idx] = offspring[0];
+    this->write(rep_idx, offspring[0]);
 
   if (fit_off > s->best.score.fitness)
   {
@@ -161,6 +205,8 @@ unsigned alps<T>::allowed_age(unsigned l) const
 template<class T>
 void alps<T>::try_move_up_layer(unsigned l)
 {
+  VITA_TRACE_SCOPE("ALPS move up layer");
+
   auto &pop(this->pop_);
 
   if (l + 1 < pop.layers())
@@ -187,14 +233,12 @@ void alps<T>::try_move_up_layer(unsigned l)
 template<class T>
 bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming)
 {
-  using coord = typename population<T>::coord;
-
   auto &p(this->pop_);
   assert(layer < p.layers());
 
   if (p.individuals(layer) < p.allowed(layer))
   {
-    p.add_to_layer(layer, incoming);  // layer not full... inserting incoming
+    this->append(layer, incoming);  // layer not full... inserting incoming
     return true;
   }
 
@@ -202,13 +246,13 @@ bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming)
   const auto m_age(allowed_age(layer));
 
   // Well, let's see if the worst individual we can find with a tournament...
-  coord c_worst{layer, random::sup(p.individuals(layer))};
+  typename alps::coord c_worst{layer, random::sup(p.individuals(layer))};
   auto f_worst(this->eva_(p[c_worst]));
 
   auto rounds(p.get_problem().env.tournament_size);
   while (rounds--)
   {
-    const coord c_x{layer, random::sup(p.individuals(layer))};
+    const typename alps::coord c_x{layer, random::sup(p.individuals(layer))};
     const auto f_x(this->eva_(p[c_x]));
 
     if ((p[c_x].age() > p[c_worst].age() && p[c_x].age() > m_age) ||
@@ -227,7 +271,7 @@ bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming)
   {
     if (layer + 1 < p.layers())
       try_add_to_layer(layer + 1, p[c_worst]);
-    p[c_worst] = incoming;
+    this->write(c_worst, incoming);
 
     return true;
   }
@@ -362,7 +406,7 @@ void pareto<T>::run(
   }
 
   if (elitism == trilean::no || !dominated)
-    pop[parent.back()] = offspring[0];
+    this->write(parent.back(), offspring[0]);
 
   if (fit_off > s->best.score.fitness)
   {
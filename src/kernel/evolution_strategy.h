@@ -16,6 +16,7 @@
 #include "kernel/evolution_recombination.h"
 #include "kernel/evolution_replacement.h"
 #include "kernel/evolution_selection.h"
+#include "utility/async_writer.h"
 
 namespace vita
 {
@@ -55,7 +56,7 @@ public:
 
   /// Evolution strategy specific log function (it's called by the
   /// `evolution::log` method).
-  void log_strategy(unsigned, unsigned) const {}
+  void log_strategy(unsigned, unsigned, async_writer &) const {}
 
   /// Sets strategy-specific parameters.
   static environment shape(environment env) { return env; }
@@ -138,7 +139,7 @@ class basic_alps_es : public evolution_strategy<T,
 public:
   using basic_alps_es::evolution_strategy::evolution_strategy;
 
-  void log_strategy(unsigned, unsigned) const;
+  void log_strategy(unsigned, unsigned, async_writer &) const;
   void after_generation();
 
   static environment shape(environment);
@@ -75,6 +75,8 @@ environment basic_alps_es<T, CS>::shape(environment env)
 template<class T, template<class> class CS>
 void basic_alps_es<T, CS>::after_generation()
 {
+  VITA_TRACE_SCOPE("ALPS layers");
+
   const auto &sum(this->sum_);
   auto &pop(this->pop_);
   const auto &env(pop.get_problem().env);
@@ -118,25 +120,24 @@ void basic_alps_es<T, CS>::after_generation()
 ///
 /// Saves working / statistical informations about layer status.
 ///
-/// \param[in] last_run    last run processed
-/// \param[in] current_run current run
+/// \param[in]  last_run    last run processed
+/// \param[in]  current_run current run
+/// \param[out] w           writer used for the log file
 ///
 /// Parameters from the environment:
 /// * `env.stat.layers_file` if empty the method will not write any data.
 ///
 template<class T, template<class> class CS>
 void basic_alps_es<T, CS>::log_strategy(unsigned last_run,
-                                        unsigned current_run) const
+                                        unsigned current_run,
+                                        async_writer &w) const
 {
   const auto &pop(this->pop_);
   const auto &env(pop.get_problem().env);
 
   if (!env.stat.layers_file.empty())
   {
-    const std::string n_lys(merge_path(env.stat.dir, env.stat.layers_file));
-    std::ofstream f_lys(n_lys, std::ios_base::app);
-    if (!f_lys.good())
-      return;
+    std::ostringstream f_lys;
 
     if (last_run != current_run)
       f_lys << "\n\n";
@@ -162,6 +163,8 @@ void basic_alps_es<T, CS>::log_strategy(unsigned last_run,
             << '-' << this->sum_->az.fit_dist(l).max()
             << ' ' << pop.individuals(l) << '\n';
     }
+
+    w.write(merge_path(env.stat.dir, env.stat.layers_file), f_lys.str());
   }
 }
 #endif  // include guard
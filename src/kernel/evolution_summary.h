@@ -17,6 +17,7 @@
 
 #include "kernel/analyzer.h"
 #include "kernel/model_measurements.h"
+#include "kernel/perf_counters.h"
 
 namespace vita
 {
@@ -34,6 +35,9 @@ public:
 
   void clear();
 
+  double evaluations_per_second() const;
+  double requests_per_second() const;
+
   // --- Serialization ---
   bool load(std::istream &, const problem &);
   bool save(std::ostream &) const;
@@ -56,6 +60,9 @@ public:
   /// Number of mutations performed.
   std::uintmax_t mutations;
 
+  /// Where the time goes (evaluations, cache efficiency, phase timers).
+  perf_counters perf;
+
   unsigned gen, last_imp;
 };
 
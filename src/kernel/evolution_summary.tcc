@@ -22,7 +22,8 @@
 ///
 template<class T>
 summary<T>::summary() : az(), best{T(), model_measurements()}, elapsed(0),
-                        crossovers(0), mutations(0), gen(0), last_imp(0)
+                        crossovers(0), mutations(0), perf(), gen(0),
+                        last_imp(0)
 {
 }
 
@@ -35,6 +36,30 @@ void summary<T>::clear()
   *this = summary<T>();
 }
 
+///
+/// \return number of fitness evaluations (cache hits excluded) per second of
+///         elapsed time
+///
+template<class T>
+double summary<T>::evaluations_per_second() const
+{
+  const std::chrono::duration<double> s(elapsed);
+  return s.count() > 0.0 ? static_cast<double>(perf.evaluations) / s.count()
+                         : 0.0;
+}
+
+///
+/// \return number of fitness requests (cache hits included) per second of
+///         elapsed time
+///
+template<class T>
+double summary<T>::requests_per_second() const
+{
+  const std::chrono::duration<double> s(elapsed);
+  return s.count() > 0.0 ? static_cast<double>(perf.requests) / s.count()
+                         : 0.0;
+}
+
 ///
 /// Loads the object from a stream.
 ///
@@ -95,7 +120,8 @@ template<class T>
 bool summary<T>::save(std::ostream &out) const
 {
   // analyzer az doesn't need to be saved: it'll be recalculated at the
-  // beginning of evolution.
+  // beginning of evolution. Performance counters are specific to the
+  // process and aren't saved either.
 
   if (best.solution.empty())
     out << "0\n";
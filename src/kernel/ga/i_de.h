@@ -16,6 +16,8 @@
 #include "kernel/individual.h"
 #include "kernel/range.h"
 
+#include "utility/span.h"
+
 namespace vita
 {
 ///
@@ -55,6 +57,7 @@ public:
   }
 
   operator std::vector<value_type>() const;
+  operator span<const value_type>() const;
   i_de &operator=(const std::vector<value_type> &);
 
   i_de crossover(double, const range_t<double> &,
@@ -129,6 +132,22 @@ inline i_de::iterator i_de::end()
   return genome_.end();
 }
 
+///
+/// A view of the genome as a sequence of real values.
+///
+/// \return a read-only view of the genome
+///
+/// \remark
+/// Unlike the conversion to `std::vector` this doesn't copy the genome (the
+/// view is valid until the individual is modified or destroyed). Objective
+/// functions taking a `span<const value_type>` argument evaluate individuals
+/// without memory allocations.
+///
+inline i_de::operator span<const i_de::value_type>() const
+{
+  return {genome_.data(), genome_.size()};
+}
+
 }  // namespace vita
 
 #endif  // include guard
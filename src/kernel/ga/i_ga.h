@@ -16,6 +16,8 @@
 #include "kernel/gene.h"
 #include "kernel/individual.h"
 
+#include "utility/span.h"
+
 namespace vita
 {
 
@@ -54,6 +56,7 @@ public:
   }
 
   operator std::vector<value_type>() const;
+  operator span<const value_type>() const;
   i_ga &operator=(const std::vector<value_type> &);
 
   // Recombination operators.
@@ -145,6 +148,22 @@ inline i_ga::iterator i_ga::end()
   return genome_.end();
 }
 
+///
+/// A view of the genome as a sequence of integer values.
+///
+/// \return a read-only view of the genome
+///
+/// \remark
+/// Unlike the conversion to `std::vector` this doesn't copy the genome (the
+/// view is valid until the individual is modified or destroyed). Objective
+/// functions taking a `span<const value_type>` argument evaluate individuals
+/// without memory allocations.
+///
+inline i_ga::operator span<const i_ga::value_type>() const
+{
+  return {genome_.data(), genome_.size()};
+}
+
 }  // namespace vita
 
 #endif  // include guard
@@ -13,11 +13,12 @@
 #if !defined(VITA_GENE_H)
 #define      VITA_GENE_H
 
+#include <array>
+
 #include "kernel/locus.h"
 #include "kernel/function.h"
 #include "kernel/random.h"
 #include "kernel/terminal.h"
-#include "utility/small_vector.h"
 #include "utility/utility.h"
 
 namespace vita
@@ -29,6 +30,12 @@ namespace vita
 ///
 /// The class `gene` is the building block of a `i_mep` individual.
 ///
+/// \remark
+/// The layout is compact and trivially copyable (a pointer plus eight bytes
+/// for `K == 4`): genomes are copied and compared with a fraction of the
+/// memory bandwidth required by a layout with separate parameter / argument
+/// storage.
+///
 template<unsigned K>
 class basic_gene
 {
@@ -42,14 +49,24 @@ public:
 
   // Types and constants.
   using packed_index_t = std::uint16_t;
-  using arg_pack = small_vector<packed_index_t, K>;
+
+  /// Indices of the arguments. Only the first `sym->arity()` elements are
+  /// meaningful.
+  using arg_pack = std::array<packed_index_t, K>;
 
   enum : decltype(K) {k_args = K};
 
   // Public data members.
-  const symbol     *sym;
-  terminal::param_t par;
-  arg_pack         args;
+  const symbol *sym;
+
+  // A function has arguments and no parameter, a terminal may have a
+  // parameter and never has arguments: the two pieces of information share
+  // the same storage. The active member is determined by `sym`.
+  union
+  {
+    terminal::param_t par;
+    arg_pack         args;
+  };
 
 private:
   void init_if_parametric();
@@ -63,13 +80,24 @@ bool operator==(const basic_gene<K> &, const basic_gene<K> &);
 template<unsigned K>
 bool operator!=(const basic_gene<K> &, const basic_gene<K> &);
 
+#if !defined(VITA_MEP_MAX_ARITY)
+#  define VITA_MEP_MAX_ARITY 5
+#endif
+
 ///
 /// A basic_gene with the standard size.
 ///
-/// A gene supports functions with more than 4 arguments (with a performance
-/// penality).
+/// A gene supports functions with up to 5 arguments (the widest built-in
+/// primitive is `real::ifb`). Problems using only functions with fewer
+/// arguments can define the `VITA_MEP_MAX_ARITY` macro (e.g.
+/// `-DVITA_MEP_MAX_ARITY=4` gives a 16 bytes gene on 64-bit platforms).
+///
+/// \remark
+/// `symbol_set::insert` rejects functions with more than `gene::k_args`
+/// arguments.
 ///
-using gene = basic_gene<4>;
+using gene = basic_gene<VITA_MEP_MAX_ARITY>;
+static_assert(std::is_trivially_copyable_v<gene>);
 
 #include "kernel/gene.tcc"
 }  // namespace vita
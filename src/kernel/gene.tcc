@@ -26,7 +26,7 @@
 /// This is usually called for filling the patch section of an individual.
 ///
 template<unsigned K>
-basic_gene<K>::basic_gene(const terminal &t) : sym(&t), args(0)
+basic_gene<K>::basic_gene(const terminal &t) : sym(&t), par()
 {
   init_if_parametric();
 }
@@ -59,10 +59,14 @@ void basic_gene<K>::init_if_parametric()
 ///
 template<unsigned K>
 basic_gene<K>::basic_gene(const std::pair<symbol *, std::vector<index_t>> &g)
-  : sym(g.first), args(g.first->arity())
+  : sym(g.first), par()
 {
   if (sym->arity())
   {
+    Expects(g.second.size() == sym->arity());
+    Expects(sym->arity() <= K);
+
+    args = {};
     std::transform(g.second.begin(), g.second.end(), args.begin(),
                    [](index_t i)
                    {
@@ -87,16 +91,17 @@ basic_gene<K>::basic_gene(const std::pair<symbol *, std::vector<index_t>> &g)
 ///
 template<unsigned K>
 basic_gene<K>::basic_gene(const symbol &s, index_t from, index_t sup)
-  : sym(&s), args(s.arity())
+  : sym(&s), par()
 {
   Expects(from < sup);
 
-
-  if (s.arity())
+  if (const auto arity = s.arity())
   {
+    Expects(arity <= K);
     assert(sup <= std::numeric_limits<packed_index_t>::max());
 
-    std::generate(args.begin(), args.end(),
+    args = {};
+    std::generate(args.begin(), std::next(args.begin(), arity),
                   [from, sup]()
                   {
                     return random::between<packed_index_t>(from, sup);
@@ -131,9 +136,9 @@ bool operator==(const basic_gene<K> &g1, const basic_gene<K> &g2)
 
   assert(g1.sym->arity() == g2.sym->arity());
 
-  if (g1.sym->arity())
-    return std::equal(g1.args.begin(), g1.args.end(),
-                      g2.args.begin(), g2.args.end());
+  if (const auto arity = g1.sym->arity())
+    return std::equal(g1.args.begin(), std::next(g1.args.begin(), arity),
+                      g2.args.begin());
 
   assert(g1.sym->terminal());
   const auto t(terminal::cast(g1.sym));
@@ -13,6 +13,9 @@
 #include <algorithm>
 #include <functional>
 #include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
 
 #include "kernel/i_mep.h"
 #include "kernel/adf.h"
@@ -23,6 +26,58 @@
 
 namespace vita
 {
+
+namespace
+{
+
+template<class F, std::size_t... Cs>
+void for_each_category(F &f, std::index_sequence<Cs...>)
+{
+  (f(static_cast<category_t>(Cs)), ...);
+}
+
+///
+/// Calls `f(c)` for every category `c` in the `[0;c_sup[` range.
+///
+/// \param[in] c_sup number of categories of the genome
+/// \param[in] f     function to be called
+///
+/// With a compile-time number of categories (`VITA_MEP_CATEGORIES`) the loop
+/// is fully unrolled.
+///
+template<class F>
+void for_each_category([[maybe_unused]] category_t c_sup, F f)
+{
+  if constexpr (VITA_MEP_CATEGORIES != 0)
+  {
+    assert(c_sup == VITA_MEP_CATEGORIES);
+    for_each_category(f, std::make_index_sequence<VITA_MEP_CATEGORIES>());
+  }
+  else
+    for (category_t c(0); c < c_sup; ++c)
+      f(c);
+}
+
+///
+/// \param[in] n     a dimension of the genome
+/// \param[in] fixed the corresponding compile-time dimension (`0` if decided
+///                  at run time)
+/// \param[in] what  name of the dimension
+/// \return          `n`
+///
+/// \exception std::invalid_argument `n` differs from the compile-time value
+///
+std::size_t checked_dim(std::size_t n, std::size_t fixed,
+                        const std::string &what)
+{
+  if (fixed && n != fixed)
+    throw std::invalid_argument(what + " must be " + std::to_string(fixed)
+                                + " (compile-time genome shape)");
+  return n;
+}
+
+}  // unnamed namespace
+
 ///
 /// Generates the initial, random expressions that make up an individual.
 ///
@@ -31,8 +86,16 @@ namespace vita
 /// The constructor is implemented so as to ensure that there is no violation
 /// of the type system's constraints.
 ///
+/// \exception std::invalid_argument code length / number of categories of
+///                                   the problem don't match the
+///                                   compile-time genome shape
+///
 i_mep::i_mep(const problem &p)
-  : individual(), genome_(p.env.mep.code_length, p.sset.categories()),
+  : individual(),
+    genome_(checked_dim(p.env.mep.code_length, VITA_MEP_CODE_LENGTH,
+                        "Code length"),
+            checked_dim(p.sset.categories(), VITA_MEP_CATEGORIES,
+                        "Number of categories")),
     best_{0, 0}, active_crossover_type_(random::sup(NUM_CROSSOVERS))
 {
   Expects(size());
@@ -45,13 +108,17 @@ i_mep::i_mep(const problem &p)
 
   // STANDARD SECTION. Filling the genome with random symbols.
   for (index_t i(0); i < patch; ++i)
-    for (category_t c(0); c < c_sup; ++c)
+    for_each_category(c_sup, [&](category_t c)
+    {
       genome_(i, c) = gene(p.sset.roulette(c), i + 1, i_sup);
+    });
 
   // PATCH SUBSECTION. Placing terminals for satisfying constraints on types.
   for (index_t i(patch); i < i_sup; ++i)
-    for (category_t c(0); c < c_sup; ++c)
+    for_each_category(c_sup, [&](category_t c)
+    {
       genome_(i, c) = gene(p.sset.roulette_terminal(c));
+    });
 
   Ensures(debug());
 }
@@ -63,14 +130,20 @@ i_mep::i_mep(const problem &p)
 ///
 /// This is useful for debugging purpose (i.e. setup *ad-hoc* individuals).
 ///
+/// \exception std::invalid_argument the shape of `gv` doesn't match the
+///                                   compile-time genome shape
+///
 i_mep::i_mep(const std::vector<gene> &gv)
   : individual(),
-    genome_(gv.size(),
-            std::max_element(std::begin(gv), std::end(gv),
-                             [](gene g1, gene g2)
-                             {
-                               return g1.sym->category() < g2.sym->category();
-                             })->sym->category() + 1),
+    genome_(checked_dim(gv.size(), VITA_MEP_CODE_LENGTH, "Code length"),
+            checked_dim(std::max_element(
+                          std::begin(gv), std::end(gv),
+                          [](gene g1, gene g2)
+                          {
+                            return g1.sym->category()
+                                   < g2.sym->category();
+                          })->sym->category() + 1,
+                        VITA_MEP_CATEGORIES, "Number of categories")),
     best_{0, 0},
     active_crossover_type_(random::sup(NUM_CROSSOVERS))
 {
@@ -143,7 +216,10 @@ unsigned i_mep::mutation(double pgm, const problem &prb)
   const auto i_size(size());
   const auto patch(i_size - prb.env.mep.patch_length);
 
-  for (auto i(begin()); i != end(); ++i)  // Here mutation affects only exons
+  // Here mutation affects only exons. Genes are read via constant iterators so
+  // that only the changed blocks are detached from the (shared) genome.
+  const i_mep &self(*this);
+  for (auto i(self.begin()); i != self.end(); ++i)
     if (random::boolean(pgm))
     {
       const auto ix(i.locus().index);
@@ -155,7 +231,7 @@ unsigned i_mep::mutation(double pgm, const problem &prb)
       if (*i != g)
       {
         ++n;
-        *i = g;
+        genome_(i.locus()) = g;
       }
     }
 
@@ -343,12 +419,12 @@ unsigned distance(const i_mep &lhs, const i_mep &rhs)
 
   unsigned d(0);
   for (index_t i(0); i < i_sup; ++i)
-    for (category_t c(0); c < c_sup; ++c)
+    for_each_category(c_sup, [&](category_t c)
     {
       const locus l{i, c};
       if (lhs[l] != rhs[l])
         ++d;
-    }
+    });
 
   return d;
 }
@@ -487,15 +563,17 @@ bool i_mep::debug() const
 
       // Correspondence between arity of the symbol and numbers of parameters.
       const auto arity(genome_(l).sym->arity());
-      if (genome_(l).args.size() != arity)
+      if (arity > gene::k_args)
       {
-        vitaERROR << "Arity and actual arguments don't match";
+        vitaERROR << "Arity exceeds the maximum number of arguments";
         return false;
       }
 
       // Checking arguments' addresses.
-      for (const auto &arg : genome_(l).args)
+      for (auto j(decltype(arity){0}); j < arity; ++j)
       {
+        const auto arg(genome_(l).args[j]);
+
         // Arguments' addresses must be smaller than the size of the genome.
         if (arg >= size())
         {
@@ -567,8 +645,26 @@ bool i_mep::debug() const
 ///
 bool i_mep::load_impl(std::istream &in, const symbol_set &ss)
 {
+  // The header line is `rows cols crossover`. The crossover type (inherited
+  // by the offspring, so part of the state of the evolution) has been added
+  // later: when it's missing the default type is assumed.
+  std::string header;
+  if (!std::getline(in >> std::ws, header))
+    return false;
+
+  std::istringstream hs(header);
   unsigned rows, cols;
-  if (!(in >> rows >> cols))
+  if (!(hs >> rows >> cols))
+    return false;
+
+  unsigned crossover(crossover_t{});
+  if (!(hs >> std::ws).eof()
+      && (!(hs >> crossover) || crossover >= NUM_CROSSOVERS))
+    return false;
+
+  // Individuals with a different compile-time shape cannot be loaded.
+  if (rows && ((VITA_MEP_CODE_LENGTH && rows != VITA_MEP_CODE_LENGTH)
+               || (VITA_MEP_CATEGORIES && cols != VITA_MEP_CATEGORIES)))
     return false;
 
   // The matrix class has a basic support for serialization but we cannot
@@ -576,34 +672,33 @@ bool i_mep::load_impl(std::istream &in, const symbol_set &ss)
   // (among other things it needs access to the symbol_set to decode the
   // symbols).
   decltype(genome_) genome(rows, cols);
-  for (auto &g : genome)
-  {
-    opcode_t opcode;
-    if (!(in >> opcode))
-      return false;
-
-    gene temp;
+  for (index_t r(0); r < rows; ++r)
+    for (category_t c(0); c < cols; ++c)
+    {
+      opcode_t opcode;
+      if (!(in >> opcode))
+        return false;
 
-    temp.sym = ss.decode(opcode);
-    if (!temp.sym)
-      return false;
+      gene temp;
 
-    if (temp.sym->terminal() && terminal::cast(temp.sym)->parametric())
-      if (!(in >> temp.par))
+      temp.sym = ss.decode(opcode);
+      if (!temp.sym)
         return false;
 
-    auto arity(temp.sym->arity());
-    if (arity)
-    {
-      temp.args.resize(arity);
+      if (temp.sym->terminal() && terminal::cast(temp.sym)->parametric())
+        if (!(in >> temp.par))
+          return false;
 
-      for (auto &arg : temp.args)
-        if (!(in >> arg))
+      const auto arity(temp.sym->arity());
+      if (arity > gene::k_args)
+        return false;
+
+      for (auto i(decltype(arity){0}); i < arity; ++i)
+        if (!(in >> temp.args[i]))
           return false;
-    }
 
-    g = temp;
-  }
+      genome(r, c) = temp;
+    }
 
   auto best(locus::npos());
 
@@ -612,6 +707,7 @@ bool i_mep::load_impl(std::istream &in, const symbol_set &ss)
 
   best_ = best;
   genome_ = genome;
+  active_crossover_type_ = static_cast<crossover_t>(crossover);
 
   return true;
 }
@@ -622,20 +718,24 @@ bool i_mep::load_impl(std::istream &in, const symbol_set &ss)
 ///
 bool i_mep::save_impl(std::ostream &out) const
 {
-  out << genome_.rows() << ' ' << genome_.cols() << '\n';
-  for (const auto &g : genome_)
-  {
-    out << g.sym->opcode();
+  out << genome_.rows() << ' ' << genome_.cols() << ' '
+      << active_crossover_type_ << '\n';
+  for (index_t r(0); r < size(); ++r)
+    for (category_t c(0); c < categories(); ++c)
+    {
+      const gene &g(genome_(r, c));
 
-    if (g.sym->terminal() && terminal::cast(g.sym)->parametric())
-      out << ' ' << g.par;
+      out << g.sym->opcode();
 
-    const auto arity(g.sym->arity());
-    for (auto i(decltype(arity){0}); i < arity; ++i)
-      out << ' ' << g.args[i];
+      if (g.sym->terminal() && terminal::cast(g.sym)->parametric())
+        out << ' ' << g.par;
 
-    out << '\n';
-  }
+      const auto arity(g.sym->arity());
+      for (auto i(decltype(arity){0}); i < arity; ++i)
+        out << ' ' << g.args[i];
+
+      out << '\n';
+    }
 
   if (!empty())
     out << best().index << ' ' << best().category << '\n';
@@ -773,6 +873,10 @@ i_mep i_mep::cse() const
 /// \note Parents must have the same size.
 ///
 /// \remark
+/// The offspring shares with its parents the genome blocks that aren't
+/// changed by the crossover (see `cow_matrix`).
+///
+/// \remark
 /// What has to be noticed is that the adaption of the parameter happens before
 /// the fitness is given to it. That means that getting a good parameter
 /// doesn't rise the individual's fitness but only its performance over time.
@@ -796,32 +900,20 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
   case i_mep::crossover_t::one_point:
     {
     const auto i_sup(from.size());
-    const auto c_sup(from.categories());
     const auto cut(random::between<index_t>(1, i_sup - 1));
 
-    for (index_t i(cut); i < i_sup; ++i)
-      for (category_t c(0); c < c_sup; ++c)
-      {
-        const locus l{i, c};
-        to.genome_(l) = from[l];
-      }
+    to.genome_.assign_rows(from.genome_, cut, i_sup);
     }
     break;
 
   case i_mep::crossover_t::two_points:
     {
     const auto i_sup(from.size());
-    const auto c_sup(from.categories());
 
     const auto cut1(random::sup(i_sup - 1));
     const auto cut2(random::between(cut1 + 1, i_sup));
 
-    for (index_t i(cut1); i != cut2; ++i)
-      for (category_t c(0); c < c_sup; ++c)
-      {
-        const locus l{i, c};
-        to.genome_(l) = from[l];
-      }
+    to.genome_.assign_rows(from.genome_, cut1, cut2);
     }
     break;
 
@@ -831,12 +923,14 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
     const auto c_sup(from.categories());
 
     for (index_t i(0); i != i_sup; ++i)
-      for (category_t c(0); c < c_sup; ++c)
+      for_each_category(c_sup, [&](category_t c)
+      {
         if (random::boolean())
         {
           const locus l{i, c};
-          to.genome_(l) = from[l];
+          to.genome_.set(l, from[l]);
         }
+      });
     }
     break;
 
@@ -844,7 +938,7 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
     {
       auto crossover_ = [&](locus l, const auto &lambda) -> void
       {
-        to.genome_(l) = from[l];
+        to.genome_.set(l, from[l]);
 
         if (!from[l].sym->terminal())
         {
@@ -19,7 +19,16 @@
 #include "kernel/function.h"
 #include "kernel/gene.h"
 #include "kernel/individual.h"
-#include "utility/matrix.h"
+#include "utility/cow_matrix.h"
+#include "utility/pool_allocator.h"
+
+#if !defined(VITA_MEP_CODE_LENGTH)
+#  define VITA_MEP_CODE_LENGTH 0
+#endif
+
+#if !defined(VITA_MEP_CATEGORIES)
+#  define VITA_MEP_CATEGORIES 0
+#endif
 
 namespace vita
 {
@@ -29,6 +38,22 @@ namespace vita
 /// Each individual contains a genome which represents a possible solution to
 /// the task being tackled (i.e. a point in the search space).
 ///
+/// \remark
+/// By default the shape of the genome is read from the problem at run time
+/// (`environment::mep::code_length`, number of categories of the symbol set).
+/// When a program always uses the same configuration, the
+/// `VITA_MEP_CODE_LENGTH` / `VITA_MEP_CATEGORIES` macros fix it at compile
+/// time: genome blocks become `std::array`s, copying an individual doesn't
+/// allocate, loops over categories are unrolled and the traversal of the
+/// active code uses a fixed-size bitset with constant strides. Creating an
+/// individual with a different shape throws `std::invalid_argument`.
+///
+/// \warning
+/// The macros change the layout of `i_mep`: the library and every program
+/// using it must be compiled with the same values. Use the CMake cache
+/// variables with the same names (they're applied to the `vita` target and
+/// propagated to its users).
+///
 class i_mep : public individual<i_mep>
 {
 public:
@@ -102,7 +127,9 @@ private:
 
   // This is the genome: the entire collection of genes (the entirety of an
   // organism's hereditary information).
-  matrix<gene> genome_;
+  // Blocks of genes are shared, copy-on-write, among individuals: offspring
+  // only own the blocks changed by crossover / mutation.
+  cow_matrix<gene, VITA_MEP_CODE_LENGTH, VITA_MEP_CATEGORIES> genome_;
 
   // Starting point of the active code in this individual (the best sequence
   // of genes starts here).
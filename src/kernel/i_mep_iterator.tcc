@@ -39,25 +39,31 @@ public:
   /// Builds an empty iterator.
   ///
   /// Empty iterator is used as sentry (it's the value returned by end()).
-  basic_iterator() : loci_(), ind_(nullptr) {}
+  basic_iterator() : pending_(), locus_(vita::locus::npos()), ind_(nullptr) {}
 
   /// \param[in] id an individual
-  explicit basic_iterator(ind &id) : loci_({id.best_}), ind_(&id)
+  explicit basic_iterator(ind &id)
+    : pending_(make_pending(id)),
+      locus_(id.empty() ? vita::locus::npos() : id.best_), ind_(&id)
   {
   }
 
   /// \return iterator representing the next active gene
   basic_iterator &operator++()
   {
-    if (!loci_.empty())
+    if (locus_ != vita::locus::npos())
     {
-      const gene &g(operator*());
+      // Read-only access: doesn't detach the genome of a mutable individual.
+      const gene &g(std::as_const(ind_->genome_)(locus_));
 
       const auto arity(g.sym->arity());
       for (auto j(decltype(arity){0}); j < arity; ++j)
-        loci_.insert(g.arg_locus(j));
+      {
+        const auto p(position(g.arg_locus(j)));
+        pending_[p / 64] |= std::uint64_t(1) << (p % 64);
+      }
 
-      loci_.erase(loci_.begin());
+      next(position(locus_) + 1);
     }
 
     return *this;
@@ -70,8 +76,7 @@ public:
   {
     Ensures(!ind_ || !rhs.ind_ || ind_ == rhs.ind_);
 
-    return (loci_.empty() && rhs.loci_.empty()) ||
-           loci_.cbegin() == rhs.loci_.cbegin();
+    return locus_ == rhs.locus_;
   }
 
   bool operator!=(const basic_iterator &rhs) const
@@ -94,14 +99,82 @@ public:
   /// \return the locus of the current gene
   vita::locus locus() const
   {
-    return *loci_.cbegin();
+    return locus_;
   }
 
 private:
-  // A partial set of active loci to be explored.
-  // We have tried with `std::vector<bool>` and `std::vector<uint8_t>` based
-  // iterators without measuring significant speed differences.
-  std::set<vita::locus> loci_;
+  // With a compile-time genome shape the bitset has a fixed size (no
+  // allocation) and positions are computed with constant strides.
+  static constexpr std::size_t fixed_words =
+    (VITA_MEP_CODE_LENGTH * VITA_MEP_CATEGORIES + 63) / 64;
+
+  using bitset_t = std::conditional_t<
+    fixed_words != 0,
+    std::array<std::uint64_t, fixed_words>,
+    std::vector<std::uint64_t, pool_allocator<std::uint64_t>>>;
+
+  static bitset_t make_pending([[maybe_unused]] const ind &id)
+  {
+    if constexpr (fixed_words != 0)
+      return {};
+    else
+      return bitset_t(id.empty() ? 0
+                                 : (id.size() * id.categories() + 63) / 64);
+  }
+
+  std::size_t cols() const
+  {
+    if constexpr (VITA_MEP_CATEGORIES != 0)
+      return VITA_MEP_CATEGORIES;
+    else
+      return ind_->categories();
+  }
+
+  // Loci of the genome are linearized in row-major order (the same order of
+  // `locus::operator<`).
+  std::size_t position(const vita::locus &l) const
+  {
+    return l.index * cols() + l.category;
+  }
+
+  // Moves to the first pending locus at a position greater than or equal to
+  // `p` (or to the end if there isn't any).
+  void next(std::size_t p)
+  {
+    const auto cs(cols());
+
+    for (std::size_t w(p / 64); w < pending_.size(); ++w)
+    {
+      auto bits(pending_[w] >> (p % 64));
+
+      if (bits)
+      {
+        while (!(bits & 1))
+        {
+          bits >>= 1;
+          ++p;
+        }
+
+        locus_ = {static_cast<index_t>(p / cs),
+                  static_cast<category_t>(p % cs)};
+        return;
+      }
+
+      p = (w + 1) * 64;
+    }
+
+    locus_ = vita::locus::npos();
+  }
+
+  // Active loci still to be explored (a bit for every locus of the genome).
+  // Function arguments always refer to following loci so a forward scan of
+  // the bitset visits the active genes in ascending order.
+  // Memory comes from a `pool_allocator`: in the steady state the traversal
+  // doesn't call the global allocator.
+  bitset_t pending_;
+
+  // The current locus.
+  vita::locus locus_;
 
   // A pointer to the individual we are iterating on.
   ind *ind_;
@@ -0,0 +1,510 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#if !defined(WIN32) && !defined(_WIN32) && !defined(__WIN32)
+#  include <arpa/inet.h>
+#  include <fcntl.h>
+#  include <netdb.h>
+#  include <poll.h>
+#  include <sys/socket.h>
+#  include <sys/time.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#  define VITA_MIGRATION_SOCKETS
+#endif
+
+#include "kernel/migration.h"
+#include "kernel/log.h"
+
+namespace vita
+{
+
+#if defined(VITA_MIGRATION_SOCKETS)
+namespace
+{
+// Every message is a frame: type and length of the payload (two
+// `std::uint32_t` in network byte order) followed by the payload.
+constexpr std::uint32_t frame_exchange = 1;    // island -> hub: emigrants
+constexpr std::uint32_t frame_immigrants = 2;  // hub -> island
+
+constexpr std::size_t header_size = 2 * sizeof(std::uint32_t);
+constexpr std::uint32_t max_payload = 1u << 26;
+
+// A packet must fit (with its length) in the payload of a reply.
+constexpr std::uint32_t max_packet = max_payload - sizeof(std::uint32_t);
+
+#if defined(MSG_NOSIGNAL)
+constexpr int send_flags = MSG_NOSIGNAL;  // a closed peer isn't fatal
+#else
+constexpr int send_flags = 0;
+#endif
+
+void append_u32(std::string &out, std::uint32_t v)
+{
+  v = htonl(v);
+  out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+std::uint32_t peek_u32(const char *in)
+{
+  std::uint32_t v;
+  std::memcpy(&v, in, sizeof(v));
+  return ntohl(v);
+}
+
+std::string frame(std::uint32_t type, const std::string &payload)
+{
+  std::string ret;
+  ret.reserve(header_size + payload.size());
+
+  append_u32(ret, type);
+  append_u32(ret, static_cast<std::uint32_t>(payload.size()));
+  return ret + payload;
+}
+
+bool send_all(int fd, const std::string &data)
+{
+  for (std::size_t done(0); done < data.size();)
+  {
+    const auto n(::send(fd, data.data() + done, data.size() - done,
+                        send_flags));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+
+    done += static_cast<std::size_t>(n);
+  }
+
+  return true;
+}
+
+bool recv_all(int fd, char *data, std::size_t size)
+{
+  for (std::size_t done(0); done < size;)
+  {
+    const auto n(::recv(fd, data + done, size - done, 0));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+
+    done += static_cast<std::size_t>(n);
+  }
+
+  return true;
+}
+
+// Creates a stream socket for `address` and binds it (`server == true`) or
+// connects it to the address. Returns `-1` in case of failure.
+int open_socket(const std::string &address, bool server)
+{
+  if (address.rfind("unix:", 0) == 0)
+  {
+    const auto path(address.substr(5));
+
+    sockaddr_un sa{};
+    sa.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(sa.sun_path))
+      return -1;
+    std::memcpy(sa.sun_path, path.c_str(), path.size() + 1);
+
+    const int fd(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (fd < 0)
+      return -1;
+
+    const auto *addr(reinterpret_cast<const sockaddr *>(&sa));
+    bool ok;
+    if (server)
+    {
+      ::unlink(path.c_str());  // leftover of a previous hub
+      ok = ::bind(fd, addr, sizeof(sa)) == 0 && ::listen(fd, SOMAXCONN) == 0;
+    }
+    else
+      ok = ::connect(fd, addr, sizeof(sa)) == 0;
+
+    if (!ok)
+    {
+      ::close(fd);
+      return -1;
+    }
+
+    return fd;
+  }
+
+  const auto colon(address.rfind(':'));
+  if (colon == std::string::npos)
+    return -1;
+  const auto host(address.substr(0, colon)), port(address.substr(colon + 1));
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  if (server)
+    hints.ai_flags = AI_PASSIVE;
+
+  addrinfo *res;
+  if (::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(),
+                    &hints, &res))
+    return -1;
+
+  int fd(-1);
+  for (const auto *p(res); p && fd < 0; p = p->ai_next)
+  {
+    fd = ::socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+    if (fd < 0)
+      continue;
+
+    bool ok;
+    if (server)
+    {
+      const int one(1);
+      ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      ok = ::bind(fd, p->ai_addr, p->ai_addrlen) == 0
+           && ::listen(fd, SOMAXCONN) == 0;
+    }
+    else
+      ok = ::connect(fd, p->ai_addr, p->ai_addrlen) == 0;
+
+    if (!ok)
+    {
+      ::close(fd);
+      fd = -1;
+    }
+  }
+
+  ::freeaddrinfo(res);
+  return fd;
+}
+}  // namespace
+#endif
+
+///
+/// Creates a hub listening on a given address.
+///
+/// \param[in] address `unix:PATH` or `HOST:PORT` (an empty host means every
+///                    local interface)
+///
+/// \see listening
+///
+migration_hub::migration_hub(const std::string &address) : fd_(-1)
+{
+#if defined(VITA_MIGRATION_SOCKETS)
+  fd_ = open_socket(address, true);
+
+  if (fd_ >= 0 && address.rfind("unix:", 0) == 0)
+    unix_path_ = address.substr(5);
+#endif
+
+  if (!listening())
+  {
+    vitaERROR << "Cannot listen on " << address;
+  }
+}
+
+migration_hub::~migration_hub()
+{
+#if defined(VITA_MIGRATION_SOCKETS)
+  for (const auto &p : peers_)
+    ::close(p.first);
+
+  if (listening())
+    ::close(fd_);
+
+  if (!unix_path_.empty())
+    ::unlink(unix_path_.c_str());
+#endif
+}
+
+///
+/// Serves the islands until `stop()` is called.
+///
+/// Many islands are served by a single thread: exchanges are short and the
+/// hub does no real work. Sockets of the islands are non-blocking and the
+/// replies are queued, so a stalled island doesn't freeze the others.
+///
+void migration_hub::run()
+{
+#if defined(VITA_MIGRATION_SOCKETS)
+  while (listening() && !stop_)
+  {
+    std::vector<pollfd> fds;
+    fds.push_back({fd_, POLLIN, 0});
+
+    // An island with pending replies isn't read until they're sent: the
+    // queue of a stalled island cannot grow.
+    for (const auto &[fd, p] : peers_)
+      fds.push_back({fd, static_cast<short>(p.output.empty() ? POLLIN
+                                                               : POLLOUT),
+                     0});
+
+    // The timeout allows to check the stop flag.
+    const int n(::poll(fds.data(), fds.size(), 100));
+    if (n < 0 && errno != EINTR)
+    {
+      vitaERROR << "Migration hub: " << std::strerror(errno);
+      return;
+    }
+    if (n <= 0)
+      continue;
+
+    for (std::size_t i(1); i < fds.size(); ++i)
+    {
+      if (!fds[i].revents)
+        continue;
+
+      const int fd(fds[i].fd);
+      auto &p(peers_[fd]);
+
+      if (!(fds[i].events == POLLIN ? serve(fd, p) : flush(fd, p)))
+      {
+        vitaINFO << "Island " << p.id << " disconnected";
+        ::close(fd);
+        peers_.erase(fd);
+      }
+    }
+
+    if (fds[0].revents & POLLIN)
+      accept_peer();
+  }
+#endif
+}
+
+///
+/// Makes `run()` return (can be called from another thread).
+///
+void migration_hub::stop()
+{
+  stop_ = true;
+}
+
+void migration_hub::accept_peer()
+{
+#if defined(VITA_MIGRATION_SOCKETS)
+  const int fd(::accept(fd_, nullptr, nullptr));
+  if (fd < 0)
+    return;
+
+  const int flags(::fcntl(fd, F_GETFL));
+  if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+  {
+    ::close(fd);
+    return;
+  }
+
+  peers_[fd] = {next_id_, {}, {}, 0, {}};
+  vitaINFO << "Island " << next_id_ << " connected";
+  ++next_id_;
+#endif
+}
+
+// Reads the available data from an island and answers to the complete
+// requests. Returns `false` if the connection has to be closed.
+bool migration_hub::serve(int fd, peer &p)
+{
+#if defined(VITA_MIGRATION_SOCKETS)
+  char buf[64 * 1024];
+  const auto n(::recv(fd, buf, sizeof(buf), 0));
+  if (n <= 0)
+    return n < 0
+           && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK);
+  p.buffer.append(buf, static_cast<std::size_t>(n));
+
+  while (p.buffer.size() >= header_size)
+  {
+    const auto type(peek_u32(p.buffer.data()));
+    const auto len(peek_u32(p.buffer.data() + sizeof(std::uint32_t)));
+    if (type != frame_exchange || len > max_packet)
+      return false;
+
+    if (p.buffer.size() < header_size + len)
+      break;  // incomplete frame
+
+    if (len)
+      packets_[p.id] = {++next_seq_, p.buffer.substr(header_size, len)};
+    p.buffer.erase(0, header_size + len);
+
+    // Packets that don't fit in the reply are delivered by the next
+    // exchanges.
+    std::string reply;
+    for (const auto &[id, pk] : packets_)
+      if (id != p.id && p.delivered[id] < pk.seq
+          && reply.size() + sizeof(std::uint32_t) + pk.data.size()
+             <= max_payload)
+      {
+        append_u32(reply, static_cast<std::uint32_t>(pk.data.size()));
+        reply += pk.data;
+        p.delivered[id] = pk.seq;
+      }
+
+    p.output += frame(frame_immigrants, reply);
+  }
+
+  return flush(fd, p);
+#else
+  (void)fd;
+  (void)p;
+  return false;
+#endif
+}
+
+// Sends the queued replies to an island until the socket would block.
+// Returns `false` if the connection has to be closed.
+bool migration_hub::flush(int fd, peer &p)
+{
+#if defined(VITA_MIGRATION_SOCKETS)
+  while (p.sent < p.output.size())
+  {
+    const auto n(::send(fd, p.output.data() + p.sent,
+                        p.output.size() - p.sent, send_flags));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      return true;  // the rest is sent when the socket is writable
+    if (n <= 0)
+      return false;
+
+    p.sent += static_cast<std::size_t>(n);
+  }
+
+  p.output.clear();
+  p.sent = 0;
+  return true;
+#else
+  (void)fd;
+  (void)p;
+  return false;
+#endif
+}
+
+migration_link::~migration_link()
+{
+  close();
+}
+
+///
+/// \param[in] address address of the hub (see `migration_hub`)
+/// \return            `true` if the connection has been established
+///
+bool migration_link::connect(const std::string &address)
+{
+  close();
+
+#if defined(VITA_MIGRATION_SOCKETS)
+  fd_ = open_socket(address, false);
+  if (fd_ < 0)
+    return false;
+
+  // A hung hub mustn't block the island forever.
+  timeval tv{60, 0};
+  ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  ::setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+  return true;
+#else
+  (void)address;
+  return false;
+#endif
+}
+
+///
+/// Closes the connection with the hub.
+///
+void migration_link::close()
+{
+#if defined(VITA_MIGRATION_SOCKETS)
+  if (connected())
+    ::close(fd_);
+#endif
+
+  fd_ = -1;
+}
+
+///
+/// Sends a packet of emigrants and receives the packets of the other
+/// islands.
+///
+/// \param[in]  emigrants  serialized emigrants (an empty string only fetches
+///                        the immigrants)
+/// \param[out] immigrants packets sent by the other islands since the
+///                        previous exchange
+/// \return                `true` if the exchange was successful
+///
+/// \note
+/// In case of failure the connection is closed and `immigrants` isn't
+/// changed.
+///
+bool migration_link::exchange(const std::string &emigrants,
+                              std::vector<std::string> *immigrants)
+{
+  Expects(immigrants);
+
+  if (!connected())
+    return false;
+
+#if defined(VITA_MIGRATION_SOCKETS)
+  char header[header_size];
+  std::string payload;
+
+  bool ok(emigrants.size() <= max_packet
+          && send_all(fd_, frame(frame_exchange, emigrants))
+          && recv_all(fd_, header, header_size)
+          && peek_u32(header) == frame_immigrants);
+
+  if (ok)
+  {
+    const auto len(peek_u32(header + sizeof(std::uint32_t)));
+    ok = len <= max_payload;
+
+    if (ok)
+    {
+      payload.resize(len);
+      ok = recv_all(fd_, payload.data(), len);
+    }
+  }
+
+  std::vector<std::string> packets;
+  for (std::size_t pos(0); ok && pos < payload.size();)
+  {
+    ok = payload.size() - pos >= sizeof(std::uint32_t);
+    if (ok)
+    {
+      const auto len(peek_u32(payload.data() + pos));
+      pos += sizeof(std::uint32_t);
+
+      ok = payload.size() - pos >= len;
+      if (ok)
+      {
+        packets.push_back(payload.substr(pos, len));
+        pos += len;
+      }
+    }
+  }
+
+  if (!ok)
+  {
+    close();
+    return false;
+  }
+
+  *immigrants = std::move(packets);
+  return true;
+#else
+  (void)emigrants;
+  return false;
+#endif
+}
+
+}  // namespace vita
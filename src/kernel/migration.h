@@ -0,0 +1,122 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_MIGRATION_H)
+#define      VITA_MIGRATION_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "kernel/common.h"
+
+namespace vita
+{
+///
+/// Coordinator of an island model whose islands are distinct processes
+/// (possibly on distinct hosts).
+///
+/// Islands connect to the hub and periodically send a packet of emigrants
+/// (individuals serialized via their `save` member function). The reply
+/// contains the packets received from the other islands since the previous
+/// exchange (only the most recent packet of every island is kept). The size
+/// of a reply is limited: the packets exceeding the limit are delivered by
+/// the following exchanges.
+///
+/// The hub doesn't know anything about individuals: packets are opaque
+/// strings. A crashed / disconnected island simply stops sending packets.
+///
+/// Addresses have the form `unix:PATH` (Unix domain socket) or `HOST:PORT`
+/// (TCP).
+///
+/// \remark
+/// Only available on POSIX systems.
+///
+class migration_hub
+{
+public:
+  DISALLOW_COPY_AND_ASSIGN(migration_hub);
+
+  explicit migration_hub(const std::string &);
+  ~migration_hub();
+
+  /// \return `true` if the hub is accepting connections
+  bool listening() const { return fd_ >= 0; }
+
+  void run();
+  void stop();
+
+private:
+  struct peer
+  {
+    std::uint64_t id;
+    std::string buffer;  // partially received frames
+
+    std::string output;    // replies not yet sent...
+    std::size_t sent = 0;  // ... and how much of them is already gone
+
+    // Sequence number of the last packet delivered, for every source.
+    std::map<std::uint64_t, std::uint64_t> delivered;
+  };
+
+  struct packet
+  {
+    std::uint64_t seq;
+    std::string data;
+  };
+
+  void accept_peer();
+  bool serve(int, peer &);
+  bool flush(int, peer &);
+
+  int fd_;
+  std::string unix_path_;
+
+  std::map<int, peer> peers_;  // by socket descriptor
+  std::map<std::uint64_t, packet> packets_;  // by island id
+
+  std::uint64_t next_id_ = 0;
+  std::uint64_t next_seq_ = 0;
+
+  std::atomic<bool> stop_{false};
+};
+
+///
+/// Connection of an island to a `migration_hub`.
+///
+/// Every failure closes the connection: the island goes on in isolation.
+///
+class migration_link
+{
+public:
+  DISALLOW_COPY_AND_ASSIGN(migration_link);
+
+  migration_link() = default;
+  ~migration_link();
+
+  bool connect(const std::string &);
+  void close();
+
+  /// \return `true` if the island is connected to a hub
+  bool connected() const { return fd_ >= 0; }
+
+  bool exchange(const std::string &, std::vector<std::string> *);
+
+private:
+  int fd_ = -1;
+};
+
+}  // namespace vita
+
+#endif  // include guard
@@ -0,0 +1,107 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_PERF_COUNTERS_H)
+#define      VITA_PERF_COUNTERS_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace vita
+{
+///
+/// Counters and timers describing where an evolution spends its time.
+///
+/// Work counters are filled by the evaluators (see `evaluator::counters()`),
+/// timers by `evolution::run()`.
+///
+/// \remark
+/// Phases overlap: the time spent evaluating individuals is accounted for in
+/// `evaluation` and also in the phase requesting the evaluation
+/// (recombination, replacement or statistics).
+///
+struct perf_counters
+{
+  /// Number of fitness requests (cached or not).
+  std::uintmax_t requests = 0;
+  /// Number of requests reaching the real evaluator (i.e. not served by a
+  /// cache).
+  std::uintmax_t evaluations = 0;
+
+  /// Number of lookups in the fitness cache.
+  std::uintmax_t cache_probes = 0;
+  /// Number of successful lookups in the fitness cache.
+  std::uintmax_t cache_hits = 0;
+  /// Number of valid cache entries overwritten by a new one.
+  std::uintmax_t cache_evictions = 0;
+
+  /// Number of training examples processed.
+  std::uintmax_t examples = 0;
+
+  std::chrono::nanoseconds selection{0};
+  std::chrono::nanoseconds recombination{0};
+  std::chrono::nanoseconds replacement{0};
+  std::chrono::nanoseconds evaluation{0};
+  std::chrono::nanoseconds statistics{0};
+
+  perf_counters &operator+=(const perf_counters &);
+  perf_counters &operator-=(const perf_counters &);
+};
+
+///
+/// \param[in] p another set of counters
+/// \return      a reference to `*this` (every counter incremented by the
+///              corresponding value of `p`)
+///
+inline perf_counters &perf_counters::operator+=(const perf_counters &p)
+{
+  requests += p.requests;
+  evaluations += p.evaluations;
+  cache_probes += p.cache_probes;
+  cache_hits += p.cache_hits;
+  cache_evictions += p.cache_evictions;
+  examples += p.examples;
+
+  selection += p.selection;
+  recombination += p.recombination;
+  replacement += p.replacement;
+  evaluation += p.evaluation;
+  statistics += p.statistics;
+
+  return *this;
+}
+
+///
+/// \param[in] p a previous snapshot of the same counters
+/// \return      a reference to `*this` (the work done since `p`)
+///
+inline perf_counters &perf_counters::operator-=(const perf_counters &p)
+{
+  requests -= p.requests;
+  evaluations -= p.evaluations;
+  cache_probes -= p.cache_probes;
+  cache_hits -= p.cache_hits;
+  cache_evictions -= p.cache_evictions;
+  examples -= p.examples;
+
+  selection -= p.selection;
+  recombination -= p.recombination;
+  replacement -= p.replacement;
+  evaluation -= p.evaluation;
+  statistics -= p.statistics;
+
+  return *this;
+}
+
+}  // namespace vita
+
+#endif  // include guard
@@ -13,6 +13,7 @@
 #if !defined(VITA_POPULATION_H)
 #define      VITA_POPULATION_H
 
+#include <cstdint>
 #include <fstream>
 
 #include "kernel/environment.h"
@@ -57,6 +58,12 @@ public:
 
   void inc_age();
 
+  /// \return a counter incremented by every change of the layout of the
+  ///         population (layers added / removed / reinitialized, individuals
+  ///         removed...). Replacing or appending a single individual doesn't
+  ///         change it
+  std::uintmax_t revision() const { return revision_; }
+
   const problem &get_problem() const;
 
   bool debug() const;
@@ -81,6 +88,8 @@ private:
 
   std::vector<layer_t> pop_;
   std::vector<unsigned> allowed_;
+
+  std::uintmax_t revision_ = 0;
 };
 
 template<class T> typename population<T>::coord pickup(const population<T> &);
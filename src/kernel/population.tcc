@@ -52,6 +52,7 @@ void population<T>::init_layer(unsigned l)
   Expects(l < layers());
 
   pop_[l].clear();
+  ++revision_;
 
   std::generate_n(std::back_inserter(pop_[l]), allowed(l),
                   [this] {return T(get_problem()); });
@@ -101,6 +102,7 @@ void population<T>::remove_layer(unsigned l)
 
   pop_.erase(std::next(pop_.begin(), l));
   allowed_.erase(std::next(allowed_.begin(), l));
+  ++revision_;
 }
 
 ///
@@ -128,6 +130,7 @@ void population<T>::pop_from_layer(unsigned l)
 {
   Expects(l < layers());
   pop_[l].pop_back();
+  ++revision_;
 }
 
 
@@ -196,7 +199,10 @@ void population<T>::set_allowed(unsigned l, unsigned n)
     // We should consider the remove-erase idiom for deleting delta random
     // elements.
     if (delta)
+    {
       pop_[l].erase(pop_[l].end() - delta, pop_[l].end());
+      ++revision_;
+    }
   }
 
   allowed_[l] = n;
@@ -320,25 +326,31 @@ bool population<T>::load(std::istream &in, const problem &prob)
   if (!(in >> n_layers) || !n_layers)
     return false;
 
-  population p(prob);
-  p.pop_.reserve(n_layers);
-  p.allowed_.reserve(n_layers);
+  std::vector<layer_t> t_pop(n_layers);
+  std::vector<unsigned> t_allowed(n_layers);
 
   for (decltype(n_layers) l(0); l < n_layers; ++l)
   {
-    if (!(in >> p.allowed_[l]))
-      return false;
-
     unsigned n_elem(0);
-    if (!(in >> n_elem))
+    if (!(in >> t_allowed[l] >> n_elem) || n_elem > t_allowed[l])
       return false;
 
+    t_pop[l].reserve(t_allowed[l]);
+
     for (decltype(n_elem) i(0); i < n_elem; ++i)
-      if (!p[{l, i}].load(in, prob.sset))
+    {
+      T prg;
+      if (!prg.load(in, prob.sset))
         return false;
+
+      t_pop[l].push_back(prg);
+    }
   }
 
-  *this = p;
+  prob_ = &prob;
+  pop_ = std::move(t_pop);
+  allowed_ = std::move(t_allowed);
+  ++revision_;
   return true;
 }
 
@@ -0,0 +1,121 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "kernel/population_log.h"
+
+namespace vita::population_log
+{
+
+namespace
+{
+template<class T> void put(char *&p, T v)
+{
+  std::memcpy(p, &v, sizeof(v));
+  p += sizeof(v);
+}
+
+template<class T> T get(const char *&p)
+{
+  T v;
+  std::memcpy(&v, p, sizeof(v));
+  p += sizeof(v);
+  return v;
+}
+}  // namespace
+
+///
+/// Appends a text entry.
+///
+/// \param[out] out  destination buffer
+/// \param[in]  run  current run
+/// \param[in]  gen  current generation
+/// \param[in]  v    a fitness value
+/// \param[in]  freq frequency of `v`
+///
+void append_text(std::string &out, unsigned run, unsigned gen, double v,
+                 std::uintmax_t freq)
+{
+  std::ostringstream ss;
+  ss << run << ' ' << gen << ' ' << std::scientific
+     << std::setprecision(std::numeric_limits<double>::digits10 + 2)
+     << v << ' ' << freq << '\n';
+
+  out += ss.str();
+}
+
+///
+/// Appends a binary record.
+///
+/// \param[out] out  destination buffer
+/// \param[in]  run  current run
+/// \param[in]  gen  current generation
+/// \param[in]  v    a fitness value
+/// \param[in]  freq frequency of `v`
+///
+void append_binary(std::string &out, unsigned run, unsigned gen, double v,
+                   std::uintmax_t freq)
+{
+  char buf[record_size];
+  char *p(buf);
+
+  put(p, static_cast<std::uint32_t>(run));
+  put(p, static_cast<std::uint32_t>(gen));
+  put(p, v);
+  put(p, static_cast<std::uint64_t>(freq));
+
+  out.append(buf, record_size);
+}
+
+///
+/// Converts a binary population log to the text layout.
+///
+/// \param[in]  in  a binary population log
+/// \param[out] out the same data in text format
+/// \return         `false` if `in` contains a truncated record
+///
+/// The result is identical to the log produced directly in text format by a
+/// single process.
+///
+bool binary_to_text(std::istream &in, std::ostream &out)
+{
+  unsigned last_run(0);
+
+  char buf[record_size];
+  while (in.read(buf, record_size))
+  {
+    const char *p(buf);
+
+    const auto run(get<std::uint32_t>(p));
+    const auto gen(get<std::uint32_t>(p));
+    const auto v(get<double>(p));
+    const auto freq(get<std::uint64_t>(p));
+
+    std::string line;
+    if (run != last_run)
+    {
+      line = "\n\n";
+      last_run = run;
+    }
+
+    append_text(line, run, gen, v, freq);
+    out << line;
+  }
+
+  return in.gcount() == 0 && out.good();
+}
+
+}  // namespace vita::population_log
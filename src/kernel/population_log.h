@@ -0,0 +1,48 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_POPULATION_LOG_H)
+#define      VITA_POPULATION_LOG_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace vita
+{
+///
+/// Formats of the population log (`environment::statistics::population_file`).
+///
+/// Every generation the log receives one entry per bin of the fitness
+/// histogram: run, generation, fitness value, frequency.
+///
+/// - The text format is one line per entry (GNU Plot friendly); runs are
+///   separated by two empty lines.
+/// - The binary format is a sequence of fixed size records (`record_size`
+///   bytes): `run` (`uint32_t`), `generation` (`uint32_t`), `value`
+///   (`double`), `frequency` (`uint64_t`) in native byte order. It's more
+///   compact and much faster to produce; `binary_to_text` converts it to the
+///   text layout.
+///
+namespace population_log
+{
+constexpr std::size_t record_size = 24;
+
+void append_text(std::string &, unsigned, unsigned, double, std::uintmax_t);
+void append_binary(std::string &, unsigned, unsigned, double, std::uintmax_t);
+
+bool binary_to_text(std::istream &, std::ostream &);
+}  // namespace population_log
+
+}  // namespace vita
+
+#endif  // include guard
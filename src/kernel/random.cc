@@ -44,6 +44,50 @@ void seed(unsigned s)
   engine.seed(s);
 }
 
+///
+/// Returns an engine positioned at the beginning of a specific substream.
+///
+/// \param[in] master the master seed
+/// \param[in] id     index of the substream
+/// \return           an engine seeded with `master` and advanced to the
+///                   beginning of the `id`-th substream
+///
+/// Substreams are `2^192` numbers apart (see `engine_t::long_jump()`) so they
+/// never overlap in practice. Every worker thread, island or run can get its
+/// own substream from a single master seed and (multi-threaded) searches are
+/// reproducible bit by bit.
+///
+/// A substream can be further split calling `engine_t::jump()` on the
+/// returned engine (`2^64` sub-substreams of length `2^128`).
+///
+/// \remark
+/// The cost is linear in `id` (every long jump is about as expensive as 256
+/// calls to the generator).
+///
+engine_t stream(unsigned master, unsigned id)
+{
+  engine_t e(master);
+
+  for (decltype(id) i(0); i < id; ++i)
+    e.long_jump();
+
+  return e;
+}
+
+///
+/// Initalizes the random number generator of the calling thread with a
+/// specific substream.
+///
+/// \param[in] master the master seed
+/// \param[in] id     index of the substream
+///
+/// \see stream()
+///
+void seed(unsigned master, unsigned id)
+{
+  engine = stream(master, id);
+}
+
 ///
 /// Sets the shared engine to an unpredictable state.
 ///
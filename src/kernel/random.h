@@ -13,7 +13,10 @@
 #if !defined(VITA_RANDOM_H)
 #define      VITA_RANDOM_H
 
+#include <array>
 #include <cstdlib>
+#include <iterator>
+#include <limits>
 #include <random>
 #include <set>
 
@@ -49,8 +52,56 @@ unsigned ring(unsigned, unsigned, unsigned);
 bool boolean(double = 0.5);
 
 void seed(unsigned);
+void seed(unsigned, unsigned);
 void randomize();
 
+engine_t stream(unsigned, unsigned);
+
+namespace detail
+{
+
+///
+/// \param[in] range upper bound
+/// \return          a random number uniformly distributed in the `[0;range[`
+///                  range
+///
+/// Lemire's nearly-divisionless method: the (costly) modulo operation is
+/// performed only when the first extraction falls in the biased zone (a rare
+/// event for small ranges).
+///
+inline std::uint32_t bounded(std::uint32_t range)
+{
+  Expects(range);
+
+  auto m(static_cast<std::uint64_t>(engine() >> 32) * range);
+  auto l(static_cast<std::uint32_t>(m));
+
+  if (l < range)
+  {
+    const auto t(static_cast<std::uint32_t>(-range) % range);
+
+    while (l < t)
+    {
+      m = static_cast<std::uint64_t>(engine() >> 32) * range;
+      l = static_cast<std::uint32_t>(m);
+    }
+  }
+
+  return static_cast<std::uint32_t>(m >> 32);
+}
+
+///
+/// \return a random number uniformly distributed in the `[0;1[` range
+///
+/// Uses the upper 53 bits of the engine output (the precision of a `double`).
+///
+inline double unit()
+{
+  return static_cast<double>(engine() >> 11) * 0x1.0p-53;
+}
+
+}  // namespace detail
+
 ///
 /// Used for ephemeral random constant generation.
 ///
@@ -111,12 +162,29 @@ between(T min, T sup)
 /// Instead it takes a half-open range (C++ usage and same behaviour of the
 /// real number distribution).
 ///
+/// \remark
+/// Ranges smaller than `2^32` (the common case) use the Lemire's
+/// nearly-divisionless method: unbiased and usually a single multiplication
+/// per extraction.
+///
+/// \see
+/// <https://arxiv.org/abs/1805.10941>
+///
 template<class T>
 std::enable_if_t<std::is_integral<T>::value, T>
 between(T min, T sup)
 {
   Expects(min < sup);
 
+  using U = std::make_unsigned_t<T>;
+  const auto range(static_cast<std::uint64_t>(static_cast<U>(sup)
+                                              - static_cast<U>(min)));
+
+  if (range <= std::numeric_limits<std::uint32_t>::max())
+    return static_cast<T>(static_cast<U>(min)
+                          + static_cast<U>(detail::bounded(
+                              static_cast<std::uint32_t>(range))));
+
   std::uniform_int_distribution<T> d(min, sup - 1);
   return d(engine);
 }
@@ -192,10 +260,73 @@ inline bool boolean(double p)
   Expects(0.0 <= p);
   Expects(p <= 1.0);
 
-  std::bernoulli_distribution d(p);
-  return d(engine);
+  // Threshold comparison with a uniform number in the `[0;1[` range (53 bits
+  // of precision): it doesn't need a distribution object.
+  return detail::unit() < p;
+}
+
+///
+/// Fills a range with random integers uniformly distributed in the
+/// `[min;sup[` range.
+///
+/// \param[out] first beginning of the range
+/// \param[out] last  end of the range
+/// \param[in]  min   minimum random number
+/// \param[in]  sup   upper bound
+///
+/// Bulk version of `between(T, T)` (same distribution, different sequence).
+///
+/// \remark
+/// For ranges smaller than `2^32` the raw engine output is generated in
+/// blocks (`engine_t::fill`) and both halves of every 64-bit word are
+/// reduced with the Lemire's multiply-shift. The rejection threshold (the
+/// only modulo operation) is computed once per call.
+///
+template<class It, class T>
+void fill(It first, It last, T min, T sup)
+{
+  Expects(min < sup);
 
-  //return between<double>(0, 1) < p;
+  using U = std::make_unsigned_t<T>;
+  const auto range(static_cast<std::uint64_t>(static_cast<U>(sup)
+                                              - static_cast<U>(min)));
+
+  if (range > std::numeric_limits<std::uint32_t>::max())
+  {
+    for (; first != last; ++first)
+      *first = between(min, sup);
+    return;
+  }
+
+  const auto r(static_cast<std::uint32_t>(range));
+  const auto t(static_cast<std::uint32_t>(-r) % r);
+
+  const auto reduce([&](std::uint32_t x)
+  {
+    const auto m(static_cast<std::uint64_t>(x) * r);
+    if (static_cast<std::uint32_t>(m) < t)
+      return false;  // biased zone, rejected
+
+    *first = static_cast<T>(static_cast<U>(min)
+                            + static_cast<U>(m >> 32));
+    ++first;
+    return true;
+  });
+
+  std::array<engine_t::result_type, 64> block;
+  for (auto left(static_cast<std::size_t>(std::distance(first, last)));
+       left;)
+  {
+    const auto n(std::min(block.size(), (left + 1) / 2));
+    engine.fill(block.begin(), block.begin() + n);
+
+    for (std::size_t i(0); i < n && left; ++i)
+    {
+      left -= reduce(static_cast<std::uint32_t>(block[i] >> 32));
+      if (left)
+        left -= reduce(static_cast<std::uint32_t>(block[i]));
+    }
+  }
 }
 
 }  // namespace random
@@ -13,7 +13,9 @@
 #if !defined(VITA_SEARCH_H)
 #define      VITA_SEARCH_H
 
+#include "kernel/checkpoint.h"
 #include "kernel/evolution.h"
+#include "kernel/exceptions.h"
 #include "kernel/problem.h"
 #include "kernel/validation_strategy.h"
 
@@ -25,6 +27,10 @@ struct search_stats
 {
   void update(const summary<T> &);
 
+  // Serialization.
+  bool load(std::istream &, const problem &);
+  bool save(std::ostream &) const;
+
   summary<T> overall = {};
   distribution<fitness_t> fd = {};
   std::set<unsigned> good_runs = {};
@@ -72,6 +78,11 @@ protected:
   // each run.
   virtual void after_evolution(const summary<T> &);
 
+  // Returns a key identifying the data / parameters the fitness depends on.
+  // Evaluations are shared with other processes (see `shared_cache`) only if
+  // the key isn't empty.
+  virtual hash_t cache_key() const;
+
   virtual void calculate_metrics(summary<T> *) const;
 
   // Returns `true` when a validation criterion is available: i.e. it needs
@@ -86,6 +97,11 @@ protected:
   // time just before the first run.
   virtual void init();
 
+  // Template methods used to restore / save the state of the search from / to
+  // a checkpoint. Derived classes can add their own sections.
+  virtual bool load_checkpoint(const checkpoint &);
+  virtual bool save_checkpoint(checkpoint *) const;
+
   // Template method of the search::run() member function called at the end of
   // each run. Logs search statistics.
   virtual void log_stats(const search_stats<T> &,
@@ -112,6 +128,8 @@ private:
   void log_stats(const search_stats<T> &) const;
   bool load();
   bool save() const;
+  void write_checkpoint(const search_stats<T> &,
+                        const evolution<T, ES> *) const;
 };
 
 #include "kernel/search.tcc"
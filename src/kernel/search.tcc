@@ -37,6 +37,19 @@ search<T, ES> &search<T, ES>::after_generation(
   return *this;
 }
 
+///
+/// \return an empty key (evaluations aren't shared)
+///
+/// Derived classes with a knowledge of the training data can return a
+/// fingerprint of the data and of the evaluator: processes with the same key
+/// share their evaluations.
+///
+template<class T, template<class> class ES>
+hash_t search<T, ES>::cache_key() const
+{
+  return hash_t();
+}
+
 template<class T, template<class> class ES>
 bool search<T, ES>::can_validate() const
 {
@@ -185,15 +198,98 @@ summary<T> search<T, ES>::run(unsigned n)
 {
   init();
 
-  auto shake([this](unsigned g) { return vs_->shake(g); });
+  // Possibly shares the evaluations with other processes (the key depends on
+  // the current training data).
+  const auto share([this]
+                   {
+                     const auto &dir(prob_.env.misc.shared_cache_dir);
+                     if (dir.empty())
+                       return;
+
+                     if (const auto key = cache_key();
+                         key.empty() || !eva1_->share(dir, key))
+                     {
+                       vitaWARNING << "Cannot share evaluations via " << dir;
+                     }
+                   });
+
+  // A shake changes the training data and clears the evaluator (detaching the
+  // shared cache): sharing restarts with the key of the new data.
+  auto shake([&](unsigned g)
+             {
+               if (!vs_->shake(g))
+                 return false;
+
+               share();
+               return true;
+             });
   search_stats<T> stats;
 
-  for (unsigned r(0); r < n; ++r)
+  // Possibly resumes an interrupted search.
+  const std::filesystem::path ckp_file(prob_.env.misc.checkpoint_file);
+  checkpoint ckp;
+  if (!ckp_file.empty()
+      && (std::filesystem::exists(ckp_file)
+          || std::filesystem::exists(checkpoint::previous(ckp_file))))
+  {
+    if (!ckp.load(ckp_file))
+    {
+      if (!ckp.load(checkpoint::previous(ckp_file)))
+        throw exception::data_format("Corrupted checkpoint file");
+
+      vitaWARNING << "Checkpoint file " << ckp_file
+                  << " unusable, resuming from the previous one";
+    }
+
+    auto in(ckp.get("search"));
+    if (!stats.load(in, prob_))
+      throw exception::data_format("Wrong search data in checkpoint file");
+
+    vitaINFO << "Resuming search from checkpoint (run " << stats.runs
+             << ')';
+  }
+
+  const auto restore([&](evolution<T, ES> *evo)
+                     {
+                       auto in(ckp.get("evolution"));
+
+                       if (!load_checkpoint(ckp) || (evo && !evo->load(in)))
+                         throw exception::data_format(
+                           "Checkpoint doesn't match the current problem");
+
+                       ckp.clear();
+                     });
+
+  for (unsigned r(stats.runs); r < n; ++r)
   {
+    // A checkpoint saved between two runs is restored before the
+    // initialization of the next run...
+    if (!ckp.empty() && !ckp.has("evolution"))
+      restore(nullptr);
+
     vs_->init(r);
-    auto run_summary(evolution<T, ES>(prob_, *eva1_)
-                     .after_generation(after_generation_callback_)
-                     .run(r, shake));
+
+    evolution<T, ES> evo(prob_, *eva1_);
+
+    // ... while the state of a run in progress replaces the one just
+    // initialized.
+    if (!ckp.empty())
+      restore(&evo);
+
+    share();
+
+    auto callback(after_generation_callback_);
+    if (!ckp_file.empty())
+      callback = [&, this](const population<T> &pop, const summary<T> &s)
+                 {
+                   if ((s.gen + 1) % prob_.env.misc.checkpoint_interval == 0)
+                     write_checkpoint(stats, &evo);
+
+                   if (after_generation_callback_)
+                     after_generation_callback_(pop, s);
+                 };
+
+    auto run_summary(evo.after_generation(callback).run(r, shake));
     vs_->close(r);
 
     // Possibly calculates additional metrics.
@@ -203,10 +299,29 @@ summary<T> search<T, ES>::run(unsigned n)
 
     stats.update(run_summary);
     log_stats(stats);
+
+    if (!ckp_file.empty())
+      write_checkpoint(stats, nullptr);
   }
 
   close();
 
+#if defined(VITA_TRACE)
+  if (const auto &f = prob_.env.stat.trace_file; !f.empty())
+    if (!trace::save(merge_path(prob_.env.stat.dir, f)))
+    {
+      vitaWARNING << "Cannot save trace events to " << f;
+    }
+#endif
+
+  // The search is complete: there is nothing left to resume.
+  if (!ckp_file.empty())
+  {
+    std::error_code ec;
+    std::filesystem::remove(ckp_file, ec);
+    std::filesystem::remove(checkpoint::previous(ckp_file), ec);
+  }
+
   return stats.overall;
 }
 
@@ -230,12 +345,185 @@ void search_stats<T>::update(const summary<T> &r)
 
   overall.elapsed += r.elapsed;
   overall.gen += r.gen;
+  overall.perf += r.perf;
 
   ++runs;
 
   Ensures(good_runs.empty() || good_runs.count(best_run));
 }
 
+///
+/// Loads the statistics from a stream.
+///
+/// \param[in] in input stream
+/// \param[in] p  active problem
+/// \return       `true` if the object has been loaded correctly
+///
+/// \note
+/// If the load operation isn't successful the current object isn't changed.
+///
+template<class T>
+bool search_stats<T>::load(std::istream &in, const problem &p)
+{
+  search_stats tmp;
+
+  if (!tmp.overall.load(in, p))
+    return false;
+
+  bool has_fd;
+  if (!(in >> has_fd) || (has_fd && !tmp.fd.load(in)))
+    return false;
+
+  std::size_t n;
+  if (!(in >> n))
+    return false;
+  for (std::size_t i(0); i < n; ++i)
+  {
+    unsigned r;
+    if (!(in >> r))
+      return false;
+    tmp.good_runs.insert(r);
+  }
+
+  if (!(in >> tmp.best_run >> tmp.runs))
+    return false;
+
+  *this = tmp;
+  return true;
+}
+
+///
+/// Saves the statistics into a stream.
+///
+/// \param[out] out output stream
+/// \return         `true` if the object has been saved correctly
+///
+template<class T>
+bool search_stats<T>::save(std::ostream &out) const
+{
+  if (!overall.save(out))
+    return false;
+
+  out << (fd.count() ? 1 : 0) << '\n';
+  if (fd.count() && !fd.save(out))
+    return false;
+
+  out << good_runs.size();
+  for (const auto &r : good_runs)
+    out << ' ' << r;
+  out << '\n' << best_run << ' ' << runs << '\n';
+
+  return out.good();
+}
+
+///
+/// Restores the state of the search from a checkpoint.
+///
+/// \param[in] ckp a checkpoint
+/// \return        `true` if the state has been restored correctly
+///
+/// The base implementation restores the random engine, the weights of the
+/// symbols and the caches of the evaluators. Search statistics and the state
+/// of a run in progress are handled by `run()`.
+///
+template<class T, template<class> class ES>
+bool search<T, ES>::load_checkpoint(const checkpoint &ckp)
+{
+  auto in_random(ckp.get("random"));
+  random::engine_t e;
+  if (!(in_random >> e))
+    return false;
+
+  auto in_symbols(ckp.get("symbols"));
+  if (!prob_.sset.load(in_symbols))
+    return false;
+
+  if (ckp.has("cache"))
+  {
+    auto in(ckp.get("cache"));
+    if (!eva1_->load(in))
+      return false;
+  }
+
+  if (ckp.has("validation cache"))
+  {
+    auto in(ckp.get("validation cache"));
+    if (!eva2_ || !eva2_->load(in))
+      return false;
+  }
+
+  random::engine = e;
+  return true;
+}
+
+///
+/// Saves the state of the search into a checkpoint.
+///
+/// \param[out] ckp a checkpoint
+/// \return         `true` if the state has been saved correctly
+///
+/// \see load_checkpoint
+///
+template<class T, template<class> class ES>
+bool search<T, ES>::save_checkpoint(checkpoint *ckp) const
+{
+  std::ostringstream out_random;
+  if (!(out_random << random::engine))
+    return false;
+  ckp->set("random", out_random.str());
+
+  std::ostringstream out_symbols;
+  if (!prob_.sset.save(out_symbols))
+    return false;
+  ckp->set("symbols", out_symbols.str());
+
+  if (prob_.env.cache_size)
+  {
+    std::ostringstream out;
+    if (!eva1_->save(out))
+      return false;
+    ckp->set("cache", out.str());
+
+    std::ostringstream out_v;
+    if (eva2_ && eva2_->save(out_v))
+      ckp->set("validation cache", out_v.str());
+  }
+
+  return true;
+}
+
+///
+/// Writes the checkpoint file.
+///
+/// \param[in] stats statistics of the completed runs
+/// \param[in] evo   the run in progress (`nullptr` between two runs)
+///
+/// Failures are logged but don't stop the search.
+///
+template<class T, template<class> class ES>
+void search<T, ES>::write_checkpoint(const search_stats<T> &stats,
+                                     const evolution<T, ES> *evo) const
+{
+  checkpoint ckp;
+
+  std::ostringstream out_stats;
+  bool ok(stats.save(out_stats) && save_checkpoint(&ckp));
+  ckp.set("search", out_stats.str());
+
+  if (ok && evo)
+  {
+    std::ostringstream out_evo;
+    ok = evo->save(out_evo);
+    ckp.set("evolution", out_evo.str());
+  }
+
+  if (!ok || !ckp.save(prob_.env.misc.checkpoint_file))
+  {
+    vitaERROR << "Cannot write checkpoint file "
+              << prob_.env.misc.checkpoint_file;
+  }
+}
+
 ///
 /// Loads the saved evaluation cache from a file (if available).
 ///
@@ -247,7 +535,7 @@ bool search<T, ES>::load()
   if (prob_.env.misc.serialization_file.empty())
     return true;
 
-  std::ifstream in(prob_.env.misc.serialization_file);
+  std::ifstream in(prob_.env.misc.serialization_file, std::ios::binary);
   if (!in)
     return false;
 
@@ -270,7 +558,7 @@ bool search<T, ES>::save() const
   if (prob_.env.misc.serialization_file.empty())
     return true;
 
-  std::ofstream out(prob_.env.misc.serialization_file);
+  std::ofstream out(prob_.env.misc.serialization_file, std::ios::binary);
   if (!out)
     return false;
 
@@ -422,6 +710,30 @@ void search<T, ES>::log_stats(const search_stats<T> &stats,
                                  : 0);
   set_text(e_solutions, "avg_depth", avg_depth);
 
+  const auto ms([](std::chrono::nanoseconds t)
+                 {
+                   return std::chrono::duration<double, std::milli>(t).count();
+                 });
+
+  auto *e_perf(d->NewElement("performance"));
+  e_summary->InsertEndChild(e_perf);
+  set_text(e_perf, "requests", stats.overall.perf.requests);
+  set_text(e_perf, "requests_per_second",
+           stats.overall.requests_per_second());
+  set_text(e_perf, "evaluations", stats.overall.perf.evaluations);
+  set_text(e_perf, "evaluations_per_second",
+           stats.overall.evaluations_per_second());
+  set_text(e_perf, "cache_probes", stats.overall.perf.cache_probes);
+  set_text(e_perf, "cache_hits", stats.overall.perf.cache_hits);
+  set_text(e_perf, "cache_evictions", stats.overall.perf.cache_evictions);
+  set_text(e_perf, "examples", stats.overall.perf.examples);
+  set_text(e_perf, "selection_time", ms(stats.overall.perf.selection));
+  set_text(e_perf, "recombination_time",
+           ms(stats.overall.perf.recombination));
+  set_text(e_perf, "replacement_time", ms(stats.overall.perf.replacement));
+  set_text(e_perf, "evaluation_time", ms(stats.overall.perf.evaluation));
+  set_text(e_perf, "statistics_time", ms(stats.overall.perf.statistics));
+
   auto *e_other(d->NewElement("other"));
   e_summary->InsertEndChild(e_other);
   set_text(e_other,"training_evaluator", eva1_->info());
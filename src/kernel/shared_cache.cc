@@ -0,0 +1,247 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#if !defined(WIN32) && !defined(_WIN32) && !defined(__WIN32)
+#  include <fcntl.h>
+#  include <sys/file.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "kernel/shared_cache.h"
+
+namespace vita
+{
+
+namespace
+{
+// Slots are accessed concurrently by distinct processes: the atomic
+// operations must not rely on a process-local lock.
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+static_assert(sizeof(double) == sizeof(std::uint64_t));
+
+struct file_header
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t bits;
+  std::uint64_t key[2];
+  std::uint64_t slot_size;
+  char reserved[24];
+};
+static_assert(sizeof(file_header) == 64);
+
+constexpr char magic[8] = {'V', 'I', 'T', 'A', 'S', 'H', 'C', 'H'};
+constexpr std::uint32_t format_version = 1;
+
+file_header make_header(std::uint8_t bits, const hash_t &key,
+                        std::size_t slot_size)
+{
+  file_header h{};
+  std::memcpy(h.magic, magic, sizeof(magic));
+  h.version = format_version;
+  h.bits = bits;
+  h.key[0] = key.data[0];
+  h.key[1] = key.data[1];
+  h.slot_size = slot_size;
+  return h;
+}
+}  // namespace
+
+shared_cache::~shared_cache()
+{
+  detach();
+}
+
+///
+/// \param[in] bits `2^bits` is the number of slots
+/// \param[in] key  identifies the data / evaluator the fitnesses refer to
+/// \return         name of the file backing the cache
+///
+std::filesystem::path shared_cache::file_name(std::uint8_t bits,
+                                              const hash_t &key)
+{
+  std::ostringstream ss;
+  ss << "vita-" << std::hex << std::setfill('0') << std::setw(16)
+     << key.data[0] << std::setw(16) << key.data[1] << std::dec << '-'
+     << static_cast<unsigned>(bits) << ".cache";
+
+  return ss.str();
+}
+
+///
+/// Maps the shared file associated with `key`.
+///
+/// \param[in] dir  directory containing the shared files
+/// \param[in] bits `2^bits` is the number of slots
+/// \param[in] key  identifies the data / evaluator the fitnesses refer to
+/// \return         `true` if the shared cache is available
+///
+/// The file is created (and initialized) if missing. The initialization is
+/// serialized via an advisory lock, so many processes can start at the same
+/// time. A file whose header doesn't match `bits` / `key` is ignored.
+///
+bool shared_cache::attach(const std::filesystem::path &dir, std::uint8_t bits,
+                          const hash_t &key)
+{
+  Expects(bits > 0 && bits < 48);
+
+  detach();
+
+#if !defined(WIN32) && !defined(_WIN32) && !defined(__WIN32)
+  const auto path(dir / file_name(bits, key));
+  const auto header(make_header(bits, key, sizeof(slot)));
+  const std::size_t size(sizeof(header)
+                         + (std::size_t(1) << bits) * sizeof(slot));
+
+  const int fd(::open(path.c_str(), O_RDWR | O_CREAT, 0644));
+  if (fd < 0)
+    return false;
+
+  bool ok(::flock(fd, LOCK_EX) == 0);
+  if (ok)
+  {
+    struct stat st;
+    ok = ::fstat(fd, &st) == 0;
+
+    if (ok && st.st_size == 0)  // new file (slots are zero-filled)
+      ok = ::ftruncate(fd, static_cast<off_t>(size)) == 0
+           && ::pwrite(fd, &header, sizeof(header), 0)
+              == static_cast<ssize_t>(sizeof(header));
+    else if (ok)
+    {
+      file_header stored;
+      ok = static_cast<std::size_t>(st.st_size) == size
+           && ::pread(fd, &stored, sizeof(stored), 0)
+              == static_cast<ssize_t>(sizeof(stored))
+           && !std::memcmp(&stored, &header, sizeof(header));
+    }
+
+    ::flock(fd, LOCK_UN);
+  }
+
+  void *p(ok ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                      0)
+             : MAP_FAILED);
+  ::close(fd);
+
+  if (p == MAP_FAILED)
+    return false;
+
+  map_ = p;
+  map_size_ = size;
+  // Zero-filled memory is a valid representation of the (lock-free) atomic
+  // fields of an empty slot.
+  slots_ = reinterpret_cast<slot *>(static_cast<char *>(p) + sizeof(header));
+  mask_ = (std::uint64_t(1) << bits) - 1;
+
+  return true;
+#else
+  (void)dir;
+  (void)key;
+  return false;
+#endif
+}
+
+///
+/// Unmaps the shared file (the file itself isn't removed).
+///
+void shared_cache::detach()
+{
+#if !defined(WIN32) && !defined(_WIN32) && !defined(__WIN32)
+  if (map_)
+    ::munmap(map_, map_size_);
+#endif
+
+  map_ = nullptr;
+  map_size_ = 0;
+  slots_ = nullptr;
+  mask_ = 0;
+}
+
+///
+/// \param[in] h signature of an individual
+/// \return      the fitness of the individual (an empty fitness if the
+///              individual isn't available)
+///
+fitness_t shared_cache::find(const hash_t &h) const
+{
+  if (!slots_)
+    return {};
+
+  const slot &s(slots_[h.data[0] & mask_]);
+
+  const auto seq(s.seq.load(std::memory_order_acquire));
+  if (!seq || (seq & 1))
+    return {};
+
+  const hash_t sh(s.hash[0].load(std::memory_order_relaxed),
+                  s.hash[1].load(std::memory_order_relaxed));
+  const auto n(s.size.load(std::memory_order_relaxed));
+
+  std::uint64_t v[max_fitness_size];
+  for (std::size_t i(0); i < max_fitness_size; ++i)
+    v[i] = s.value[i].load(std::memory_order_relaxed);
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (s.seq.load(std::memory_order_relaxed) != seq  // torn read
+      || sh != h || !n || n > max_fitness_size)
+    return {};
+
+  fitness_t f{with_size(n)};
+  for (std::size_t i(0); i < n; ++i)
+    std::memcpy(&f[i], &v[i], sizeof(v[i]));
+
+  return f;
+}
+
+///
+/// \param[in] h signature of an individual
+/// \param[in] f fitness of the individual
+///
+/// The entry is silently dropped if the fitness is too large or if another
+/// process is writing the same slot.
+///
+void shared_cache::insert(const hash_t &h, const fitness_t &f)
+{
+  if (!slots_ || !f.size() || f.size() > max_fitness_size)
+    return;
+
+  slot &s(slots_[h.data[0] & mask_]);
+
+  auto seq(s.seq.load(std::memory_order_relaxed));
+  if ((seq & 1)
+      || !s.seq.compare_exchange_strong(seq, seq + 1,
+                                        std::memory_order_relaxed))
+    return;
+  std::atomic_thread_fence(std::memory_order_release);
+
+  s.hash[0].store(h.data[0], std::memory_order_relaxed);
+  s.hash[1].store(h.data[1], std::memory_order_relaxed);
+  s.size.store(f.size(), std::memory_order_relaxed);
+  for (std::size_t i(0); i < f.size(); ++i)
+  {
+    std::uint64_t v;
+    const double c(f[i]);
+    std::memcpy(&v, &c, sizeof(v));
+    s.value[i].store(v, std::memory_order_relaxed);
+  }
+
+  s.seq.store(seq + 2, std::memory_order_release);
+}
+
+}  // namespace vita
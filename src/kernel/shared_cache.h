@@ -0,0 +1,87 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_SHARED_CACHE_H)
+#define      VITA_SHARED_CACHE_H
+
+#include <atomic>
+#include <filesystem>
+
+#include "kernel/cache_hash.h"
+#include "kernel/common.h"
+#include "kernel/fitness.h"
+
+namespace vita
+{
+///
+/// A fitness cache shared among processes via a memory-mapped file.
+///
+/// Many searches running on the same node and on the same data (e.g. distinct
+/// seeds / parameters) can avoid recalculating each other's evaluations.
+///
+/// The file lives in a user-specified directory and its name derives from a
+/// key (a hash of the dataset and of the evaluator): a change of the data or
+/// of the evaluator maps to a different file and a stale file is never read.
+///
+/// Slots are published without locks (seqlock): a writer marks the slot as
+/// busy (odd sequence number), stores the entry and releases it with a new
+/// even sequence number; a reader accepts an entry only if the sequence
+/// number is even and unchanged across the read. A writer finding a busy
+/// slot drops its entry. Lost / torn updates are possible only as misses.
+///
+/// \remark
+/// Only available on POSIX systems (`attach` fails elsewhere).
+///
+class shared_cache
+{
+public:
+  DISALLOW_COPY_AND_ASSIGN(shared_cache);
+
+  /// Maximum number of components of a fitness stored in the cache.
+  static constexpr std::size_t max_fitness_size = 4;
+
+  shared_cache() = default;
+  ~shared_cache();
+
+  bool attach(const std::filesystem::path &, std::uint8_t, const hash_t &);
+  void detach();
+
+  /// \return `true` if the object is mapped to a shared file
+  bool attached() const { return slots_; }
+
+  fitness_t find(const hash_t &) const;
+  void insert(const hash_t &, const fitness_t &);
+
+  static std::filesystem::path file_name(std::uint8_t, const hash_t &);
+
+private:
+  struct slot
+  {
+    /// Sequence number: `0` for an empty slot, odd while being written.
+    std::atomic<std::uint64_t> seq;
+
+    std::atomic<std::uint64_t> hash[2];
+    std::atomic<std::uint64_t> size;
+    /// Bit patterns of the components of the fitness.
+    std::atomic<std::uint64_t> value[max_fitness_size];
+  };
+
+  void *map_ = nullptr;
+  std::size_t map_size_ = 0;
+
+  slot *slots_ = nullptr;
+  std::uint64_t mask_ = 0;
+};
+
+}  // namespace vita
+
+#endif  // include guard
@@ -11,6 +11,7 @@
  */
 
 #include <algorithm>
+#include <sstream>
 
 #include "kernel/src/dataframe.h"
 #include "kernel/exceptions.h"
@@ -53,6 +54,75 @@ bool is_number(const std::string &s)
                             // to `s.c_str()`
   return end != s.c_str() && *end == '\0';
 }
+
+bool load_value(std::istream &in, value_t *v)
+{
+  std::size_t type;
+  if (!(in >> type))
+    return false;
+
+  switch (type)
+  {
+  case d_void:
+    *v = {};
+    return true;
+
+  case d_int:
+    if (D_INT x; in >> x)
+    {
+      *v = x;
+      return true;
+    }
+    return false;
+
+  case d_double:
+    if (D_DOUBLE x; load_float_from_stream(in, &x))
+    {
+      *v = x;
+      return true;
+    }
+    return false;
+
+  case d_string:
+    if (std::size_t len; in >> len && in.get() == ' ')
+    {
+      D_STRING x(len, '\0');
+      if (in.read(x.data(), static_cast<std::streamsize>(len)))
+      {
+        *v = x;
+        return true;
+      }
+    }
+    return false;
+
+  default:
+    return false;
+  }
+}
+
+// Values are saved as `type value` pairs. A string is saved as
+// `type length string` (so it can contain spaces).
+void save_value(std::ostream &out, const value_t &v)
+{
+  out << v.index();
+
+  switch (v.index())
+  {
+  case d_int:
+    out << ' ' << std::get<D_INT>(v);
+    break;
+
+  case d_double:
+    out << ' ';
+    save_float_to_stream(out, std::get<D_DOUBLE>(v));
+    break;
+
+  case d_string:
+    out << ' ' << std::get<D_STRING>(v).length() << ' '
+        << std::get<D_STRING>(v);
+    break;
+  }
+}
 }  // unnamed namespace
 
 ///
@@ -718,6 +788,108 @@ dataframe::iterator dataframe::erase(iterator first, iterator last)
   return dataset_.erase(first, last);
 }
 
+///
+/// Loads the examples of the dataframe.
+///
+/// \param[in] in input stream
+/// \return       `true` if the examples have been loaded correctly
+///
+/// The current examples are replaced. Header, categories and class names
+/// aren't changed: the examples must come from a dataframe sharing the same
+/// structure.
+///
+/// \note
+/// If the load operation isn't successful the current object isn't changed.
+///
+bool dataframe::load_examples(std::istream &in)
+{
+  std::size_t n;
+  if (!(in >> n))
+    return false;
+
+  examples_t t_dataset(n);
+  for (auto &e : t_dataset)
+  {
+    std::size_t n_input;
+    if (!(in >> n_input))
+      return false;
+
+    e.input.resize(n_input);
+    for (auto &v : e.input)
+      if (!load_value(in, &v))
+        return false;
+
+    if (!load_value(in, &e.output))
+      return false;
+
+    if (!(in >> e.difficulty >> e.age))
+      return false;
+  }
+
+  dataset_ = t_dataset;
+  return true;
+}
+
+///
+/// Saves the examples of the dataframe.
+///
+/// \param[out] out output stream
+/// \return         `true` if the examples have been saved correctly
+///
+/// The order of the examples and their difficulty / age are preserved (they
+/// are changed by some validation strategies).
+///
+bool dataframe::save_examples(std::ostream &out) const
+{
+  out << size() << '\n';
+
+  for (const auto &e : *this)
+  {
+    out << e.input.size();
+    for (const auto &v : e.input)
+    {
+      out << ' ';
+      save_value(out, v);
+    }
+
+    out << ' ';
+    save_value(out, e.output);
+    out << ' ' << e.difficulty << ' ' << e.age << '\n';
+  }
+
+  return out.good();
+}
+
+///
+/// \return a hash of the examples of the dataframe
+///
+/// Only inputs and outputs are considered: difficulty / age (changed by the
+/// DSS algorithm) don't affect the result, while the order of the examples
+/// does.
+///
+hash_t dataframe::fingerprint() const
+{
+  std::ostringstream ss;
+  ss << size() << '\n';
+
+  for (const auto &e : *this)
+  {
+    ss << e.input.size();
+    for (const auto &v : e.input)
+    {
+      ss << ' ';
+      save_value(ss, v);
+    }
+
+    ss << ' ';
+    save_value(ss, e.output);
+    ss << '\n';
+  }
+
+  const auto s(ss.str());
+  return murmurhash3::hash128(s.data(), s.size());
+}
+
 ///
 /// \return `true` if the object passes the internal consistency check
 ///
@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include "kernel/cache_hash.h"
 #include "kernel/distribution.h"
 #include "kernel/problem.h"
 #include "kernel/src/category_set.h"
@@ -80,6 +81,11 @@ public:
   void clear();
   iterator erase(iterator, iterator);
 
+  // ---- Serialization (only examples) ----
+  bool load_examples(std::istream &);
+  bool save_examples(std::ostream &) const;
+  hash_t fingerprint() const;
+
   // ---- Convenience ----
   std::size_t read(const std::filesystem::path &, filter_hook_t = nullptr);
   std::size_t read_csv(std::istream &, filter_hook_t = nullptr);
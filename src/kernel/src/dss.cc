@@ -12,6 +12,7 @@
 
 #include "kernel/src/dss.h"
 #include "kernel/random.h"
+#include "utility/trace.h"
 
 namespace vita
 {
@@ -115,6 +116,8 @@ void dss::init(unsigned)
 
 void dss::shake_impl()
 {
+  VITA_TRACE_SCOPE("DSS shake");
+
   Expects(training_.size() + validation_.size() >= 2);
 
   move_to_validation();
@@ -14,6 +14,7 @@
 #define      VITA_SRC_EVALUATOR_H
 
 #include "kernel/evaluator.h"
+#include "kernel/src/output_cache.h"
 
 namespace vita
 {
@@ -32,8 +33,15 @@ class src_evaluator : public evaluator<T>
 public:
   explicit src_evaluator(dataframe &);
 
+  perf_counters counters() const override;
+
 protected:
+  void count_examples();
+
   class dataframe *dat_;
+
+  // Number of training examples processed so far.
+  std::uintmax_t examples_ = 0;
 };
 
 ///
@@ -44,6 +52,12 @@ protected:
 ///
 /// \see mse_evaluator, mae_evaluator, rmae_evaluator.
 ///
+/// \remark
+/// When evaluating teams, the outputs of every member are cached (keyed by the
+/// member's signature). A team where only some members changed after
+/// recombination reuses the outputs of the unchanged ones and only the
+/// combination step is recomputed.
+///
 template<class T>
 class sum_of_errors_evaluator : public src_evaluator<T>
 {
@@ -54,9 +68,18 @@ public:
   fitness_t fast(const T &) override;
   std::unique_ptr<basic_lambda_f> lambdify(const T &) const override;
 
+  void clear() override;
+
 private:
-  virtual double error(const basic_reg_lambda_f<T, false> &,
-                       dataframe::example &, int *) = 0;
+  fitness_t evaluate(const T &, std::false_type);
+  fitness_t evaluate(const T &, std::true_type);
+
+  template<class I> output_cache::outputs_ptr member_outputs(const I &);
+
+  virtual double error(const value_t &, dataframe::example &, int *) = 0;
+
+  // Outputs of the members of the recently evaluated teams.
+  output_cache members_;
 };
 
 ///
@@ -83,8 +106,7 @@ public:
   explicit mae_evaluator(dataframe &d) : sum_of_errors_evaluator<T>(d) {}
 
 private:
-  double error(const basic_reg_lambda_f<T, false> &, dataframe::example &,
-               int *) override;
+  double error(const value_t &, dataframe::example &, int *) override;
 };
 
 ///
@@ -113,8 +135,7 @@ public:
   explicit rmae_evaluator(dataframe &d) : sum_of_errors_evaluator<T>(d) {}
 
 private:
-  double error(const basic_reg_lambda_f<T, false> &, dataframe::example &,
-               int *) override;
+  double error(const value_t &, dataframe::example &, int *) override;
 };
 
 ///
@@ -142,8 +163,7 @@ public:
   explicit mse_evaluator(dataframe &d) : sum_of_errors_evaluator<T>(d) {}
 
 private:
-  double error(const basic_reg_lambda_f<T, false> &, dataframe::example &,
-               int *) override;
+  double error(const value_t &, dataframe::example &, int *) override;
 };
 
 ///
@@ -160,8 +180,7 @@ public:
   explicit count_evaluator(dataframe &d) : sum_of_errors_evaluator<T>(d) {}
 
 private:
-  double error(const basic_reg_lambda_f<T, false> &, dataframe::example &,
-               int *) override;
+  double error(const value_t &, dataframe::example &, int *) override;
 };
 
 ///
@@ -25,6 +25,28 @@ src_evaluator<T>::src_evaluator(dataframe &d) : dat_(&d)
 {
 }
 
+///
+/// \return counters describing the work done so far (number of training
+///         examples processed)
+///
+template<class T>
+perf_counters src_evaluator<T>::counters() const
+{
+  perf_counters ret;
+  ret.examples = examples_;
+  return ret;
+}
+
+///
+/// Accounts for a scan of the whole (active slice of the) training set.
+///
+template<class T>
+void src_evaluator<T>::count_examples()
+{
+  examples_ += static_cast<std::uintmax_t>(std::distance(dat_->begin(),
+                                                         dat_->end()));
+}
+
 ///
 /// \param[in] prg program (individual/team) used for fitness evaluation
 /// \return        the fitness (greater is better, max is `0`)
@@ -35,6 +57,13 @@ fitness_t sum_of_errors_evaluator<T>::operator()(const T &prg)
   Expects(!this->dat_->classes());
   Expects(this->dat_->begin() != this->dat_->end());
 
+  // Tag dispatching: teams take advantage of the cache of member outputs.
+  return evaluate(prg, is_team<T>());
+}
+
+template<class T>
+fitness_t sum_of_errors_evaluator<T>::evaluate(const T &prg, std::false_type)
+{
   const basic_reg_lambda_f<T, false> agent(prg);
 
   fitness_t::value_type err(0.0);
@@ -47,18 +76,94 @@ fitness_t sum_of_errors_evaluator<T>::operator()(const T &prg)
 
   for (auto &example : *this->dat_)
   {
-    err += error(agent, example, &illegals);
+    err += error(agent(example), example, &illegals);
 
     ++total_nr;
   }
 
   assert(total_nr);
+  this->examples_ += total_nr;
 
   // Note that we take the average error: this way fast() and operator()
   // outputs can be compared.
   return {-err / total_nr};
 }
 
+template<class T>
+fitness_t sum_of_errors_evaluator<T>::evaluate(const T &prg, std::true_type)
+{
+  std::vector<output_cache::outputs_ptr> outs;
+  outs.reserve(prg.individuals());
+
+  for (const auto &member : prg)
+    outs.push_back(member_outputs(member));
+
+  fitness_t::value_type err(0.0);
+  int illegals(0);
+  unsigned total_nr(0);
+
+  for (auto &example : *this->dat_)
+  {
+    // Same running average calculated by `basic_reg_lambda_f<team<T>>`.
+    D_DOUBLE avg(0), count(0);
+    for (const auto &o : outs)
+      if (const auto &res((*o)[total_nr]); has_value(res))
+        avg += (lexical_cast<D_DOUBLE>(res) - avg) / ++count;
+
+    err += error(count > 0.0 ? value_t(avg) : value_t(), example, &illegals);
+
+    ++total_nr;
+  }
+
+  assert(total_nr);
+  this->examples_ += total_nr;
+  return {-err / total_nr};
+}
+
+///
+/// \param[in] ind a member of a team
+/// \return        the outputs of `ind` over the active training set
+///
+/// Outputs are taken from the cache when available, otherwise they're
+/// calculated and stored.
+///
+template<class T>
+template<class I>
+output_cache::outputs_ptr sum_of_errors_evaluator<T>::member_outputs(
+  const I &ind)
+{
+  const auto examples(static_cast<std::size_t>(
+                        std::distance(this->dat_->begin(),
+                                      this->dat_->end())));
+
+  // The size check is a cheap protection against a dataset modified without
+  // calling `clear()`.
+  if (auto o = members_.find(ind.signature()); o && o->size() == examples)
+    return o;
+
+  const basic_reg_lambda_f<I, false> agent(ind);
+
+  output_cache::outputs_t out;
+  out.reserve(examples);
+  for (const auto &example : *this->dat_)
+    out.push_back(agent(example));
+
+  return members_.insert(ind.signature(), std::move(out));
+}
+
+///
+/// Resets the cache of member outputs.
+///
+/// \remark
+/// Must be called every time the training set changes (e.g. by the DSS
+/// algorithm).
+///
+template<class T>
+void sum_of_errors_evaluator<T>::clear()
+{
+  members_.clear();
+}
+
 ///
 /// \param[in] prg program (individual/team) used for fitness evaluation
 /// \return        the fitness (greater is better, max is `0`)
@@ -81,12 +186,13 @@ fitness_t sum_of_errors_evaluator<T>::fast(const T &prg)
   for (auto &example : *this->dat_)
     if (this->dat_->size() <= 20 || (counter++ % 5) == 0)
     {
-      err += error(agent, example, &illegals);
+      err += error(agent(example), example, &illegals);
 
       ++total_nr;
     }
 
   assert(total_nr);
+  this->examples_ += total_nr;
 
   // Note that we take the average error: this way fast() and operator()
   // outputs can be compared.
@@ -107,8 +213,8 @@ std::unique_ptr<basic_lambda_f> sum_of_errors_evaluator<T>::lambdify(
 }
 
 ///
-/// \param[in] agent        lambda function used for the evaluation of the
-///                         current program
+/// \param[in] res          output of the current program on the training case
+///                         `t`
 /// \param[in] t            the current training case
 /// \param[in,out] illegals number of illegals values found evaluating the
 ///                         current program so far
@@ -117,12 +223,12 @@ std::unique_ptr<basic_lambda_f> sum_of_errors_evaluator<T>::lambdify(
 ///                         the `[0;+inf[` range
 ///
 template<class T>
-double mae_evaluator<T>::error(const basic_reg_lambda_f<T, false> &agent,
-                               dataframe::example &t, int *illegals)
+double mae_evaluator<T>::error(const value_t &res, dataframe::example &t,
+                               int *illegals)
 {
   number err;
 
-  if (const auto res = agent(t); has_value(res))
+  if (has_value(res))
     err = std::fabs(lexical_cast<D_DOUBLE>(res) - label_as<D_DOUBLE>(t));
   else
     err = std::pow(100.0, ++(*illegals));
@@ -134,20 +240,19 @@ double mae_evaluator<T>::error(const basic_reg_lambda_f<T, false> &agent,
 }
 
 ///
-/// \param[in] agent lambda function used for the evaluation of the current
-///                  program
-/// \param[in] t     the current training case
-/// \return          a measurement of the error of the current program on the
-///                  training case `t`. The value returned is in the `[0;200]`
-///                  range
+/// \param[in] res output of the current program on the training case `t`
+/// \param[in] t   the current training case
+/// \return        a measurement of the error of the current program on the
+///                training case `t`. The value returned is in the `[0;200]`
+///                range
 ///
 template<class T>
-double rmae_evaluator<T>::error(const basic_reg_lambda_f<T, false> &agent,
-                                dataframe::example &t, int *)
+double rmae_evaluator<T>::error(const value_t &res, dataframe::example &t,
+                                int *)
 {
   number err;
 
-  if (const auto res = agent(t); has_value(res))
+  if (has_value(res))
   {
     const auto approx(lexical_cast<D_DOUBLE>(res));
     const auto target(label_as<D_DOUBLE>(t));
@@ -177,8 +282,8 @@ double rmae_evaluator<T>::error(const basic_reg_lambda_f<T, false> &agent,
 }
 
 ///
-/// \param[in] agent        lambda function used for the evaluation of the
-///                         current program
+/// \param[in] res          output of the current program on the training case
+///                         `t`
 /// \param[in] t            the current training case
 /// \param[in,out] illegals number of illegals values found evaluating the
 ///                         current program so far
@@ -186,12 +291,12 @@ double rmae_evaluator<T>::error(const basic_reg_lambda_f<T, false> &agent,
 ///                         on the training case `t`
 ///
 template<class T>
-double mse_evaluator<T>::error(const basic_reg_lambda_f<T, false> &agent,
-                               dataframe::example &t, int *illegals)
+double mse_evaluator<T>::error(const value_t &res, dataframe::example &t,
+                               int *illegals)
 {
   number err;
 
-  if (const auto res = agent(t); has_value(res))
+  if (has_value(res))
   {
     err = lexical_cast<D_DOUBLE>(res) - label_as<D_DOUBLE>(t);
     err *= err;
@@ -206,18 +311,15 @@ double mse_evaluator<T>::error(const basic_reg_lambda_f<T, false> &agent,
 }
 
 ///
-/// \param[in] agent lambda function used for the evaluation of the current
-///                  program
-/// \param[in] t     the current training case
-/// \return          a measurement of the error of the current program on the
-///                  training case `t`
+/// \param[in] res output of the current program on the training case `t`
+/// \param[in] t   the current training case
+/// \return        a measurement of the error of the current program on the
+///                training case `t`
 ///
 template<class T>
-double count_evaluator<T>::error(const basic_reg_lambda_f<T, false> &agent,
-                                 dataframe::example &t, int *)
+double count_evaluator<T>::error(const value_t &res, dataframe::example &t,
+                                 int *)
 {
-  const auto res(agent(t));
-
   const bool err(!has_value(res) ||
                  !issmall(lexical_cast<D_DOUBLE>(res) - label_as<D_DOUBLE>(t)));
 
@@ -256,6 +358,7 @@ fitness_t dyn_slot_evaluator<T>::operator()(const T &ind)
       ++example.difficulty;
     }
 
+  this->count_examples();
   return {-err};
 
   // The following code is faster but doesn't work for teams and doesn't
@@ -316,6 +419,7 @@ fitness_t gaussian_evaluator<T>::operator()(const T &ind)
       ++example.difficulty;
     }
 
+  this->count_examples();
   return {d};
 }
 
@@ -352,6 +456,7 @@ fitness_t binary_evaluator<T>::operator()(const T &ind)
       // err += std::fabs(val);
     }
 
+  this->count_examples();
   return {-err};
 }
 
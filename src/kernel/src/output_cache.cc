@@ -0,0 +1,111 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include "kernel/src/output_cache.h"
+#include "utility/contracts.h"
+
+namespace vita
+{
+///
+/// Creates a new (empty) hash table.
+///
+/// \param[in] bits `2^bits` is the number of elements of the table
+///
+/// \note
+/// Memory is allocated on the first insertion: evaluators that never use the
+/// table (e.g. when working with single individuals) don't pay for it.
+///
+output_cache::output_cache(std::uint8_t bits)
+  : k_mask((1u << bits) - 1), table_(), seal_(1), probes_(0), hits_(0)
+{
+  Expects(bits);
+  Ensures(debug());
+}
+
+///
+/// \param[in] h the signature of a program
+/// \return      an index in the hash table
+///
+inline std::size_t output_cache::index(const hash_t &h) const
+{
+  return h.data[0] & k_mask;
+}
+
+///
+/// Clears the content and the statistical informations of the table.
+///
+/// \note Allocated size isn't changed.
+///
+void output_cache::clear()
+{
+  probes_ = hits_ = 0;
+
+  ++seal_;
+}
+
+///
+/// Looks for the outputs of a program in the hash table.
+///
+/// \param[in] h program's signature to look for
+/// \return      the outputs of the program (`nullptr` if they aren't
+///              available)
+///
+output_cache::outputs_ptr output_cache::find(const hash_t &h) const
+{
+  ++probes_;
+
+  if (table_.empty())
+    return nullptr;
+
+  const slot &s(table_[index(h)]);
+  if (seal_ == s.seal && h == s.hash)
+  {
+    ++hits_;
+    return s.outputs;
+  }
+
+  return nullptr;
+}
+
+///
+/// Stores the outputs of a program in the hash table.
+///
+/// \param[in] h   a (possibly) new program's signature
+/// \param[in] out the outputs of the program
+/// \return        a pointer to the stored outputs
+///
+/// \remark
+/// The returned pointer keeps the outputs alive even if a subsequent
+/// insertion overwrites the slot.
+///
+output_cache::outputs_ptr output_cache::insert(const hash_t &h, outputs_t out)
+{
+  if (table_.empty())
+    table_.resize(k_mask + 1);
+
+  slot &s(table_[index(h)]);
+  s.hash    = h;
+  s.outputs = std::make_shared<const outputs_t>(std::move(out));
+  s.seal    = seal_;
+
+  return s.outputs;
+}
+
+///
+/// \return `true` if the object passes the internal consistency check
+///
+bool output_cache::debug() const
+{
+  return probes() >= hits();
+}
+
+}  // namespace vita
@@ -0,0 +1,85 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_SRC_OUTPUT_CACHE_H)
+#define      VITA_SRC_OUTPUT_CACHE_H
+
+#include <memory>
+#include <vector>
+
+#include "kernel/cache_hash.h"
+#include "kernel/value.h"
+
+namespace vita
+{
+///
+/// A hash table that links the signature of a program to its outputs over the
+/// active training set.
+///
+/// Mainly used for team evaluation: after a recombination usually only some
+/// members of a team change. Storing the outputs of the single members we
+/// just have to run the new members and recompute the combination step.
+///
+/// \warning
+/// Stored outputs are meaningful only for the dataset (and slice) used to
+/// compute them. The owner must call clear() every time the dataset changes.
+///
+class output_cache
+{
+public:
+  using outputs_t = std::vector<value_t>;
+  using outputs_ptr = std::shared_ptr<const outputs_t>;
+
+  explicit output_cache(std::uint8_t = 8);
+
+  void clear();
+
+  outputs_ptr insert(const hash_t &, outputs_t);
+
+  outputs_ptr find(const hash_t &) const;
+
+  /// \return number of searches in the hash table
+  /// \note Every call to the find method increment the counter.
+  std::uintmax_t probes() const { return probes_; }
+
+  /// \return number of successful searches in the hash table
+  std::uintmax_t hits() const { return hits_; }
+
+  bool debug() const;
+
+private:
+  // Private support methods.
+  std::size_t index(const hash_t &) const;
+
+  // Private data members.
+  struct slot
+  {
+    /// This is used as primary key for access to the table.
+    hash_t      hash;
+    /// The outputs of the program, one for each example of the training set.
+    outputs_ptr outputs;
+    /// Valid slots are recognized comparing their seal with the current one.
+    unsigned    seal;
+  };
+
+  std::uint64_t     k_mask;
+  std::vector<slot> table_;
+
+  decltype(slot::seal) seal_;
+
+  mutable std::uintmax_t probes_;
+  mutable std::uintmax_t   hits_;
+};
+
+}  // namespace vita
+
+#endif  // include guard
@@ -72,11 +72,16 @@ protected:
   // *** Template methods / customization points ***
   void after_evolution(const summary<T> &) override;
 
+  hash_t cache_key() const override;
+
   void calculate_metrics(summary<T> *) const override;
 
   // Requires the availability of a validation function and of validation data.
   bool can_validate() const override;
 
+  bool load_checkpoint(const checkpoint &) override;
+  bool save_checkpoint(checkpoint *) const override;
+
   void log_stats(const search_stats<T> &,
                  tinyxml2::XMLDocument *) const override;
 
@@ -101,6 +106,9 @@ private:
 
   // Metrics we have to calculate during the search.
   metric_flags metrics;
+
+  // Identity (id and parameters) of the active evaluator.
+  std::string eva_tag;
 };
 
 #include "kernel/src/search.tcc"
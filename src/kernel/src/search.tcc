@@ -95,12 +95,122 @@ std::unique_ptr<basic_src_lambda_f> src_search<T, ES>::lambdify(
   return std::unique_ptr<basic_src_lambda_f>(p);
 }
 
+///
+/// \return a fingerprint of the training examples, of the symbol set and of
+///         the active evaluator
+///
+/// Any change of the data (e.g. a different dataset or a DSS / holdout
+/// partition), of the symbols (including the code of the ADTs) or of the
+/// evaluator produces a different key. Difficulty and age of the examples
+/// and symbol weights aren't considered (they don't affect the fitness).
+///
+template<class T, template<class> class ES>
+hash_t src_search<T, ES>::cache_key() const
+{
+  if (training_data().empty())
+    return hash_t();
+
+  std::ostringstream ss;
+  ss << prob().sset.fingerprint() << eva_tag;
+
+  const auto s(ss.str());
+  auto ret(training_data().fingerprint());
+  ret.combine(murmurhash3::hash128(s.data(), s.size()));
+
+  return ret;
+}
+
 template<class T, template<class> class ES>
 bool src_search<T, ES>::can_validate() const
 {
   return search<T, ES>::can_validate() && validation_data().size();
 }
 
+///
+/// Restores the state of the search from a checkpoint.
+///
+/// \param[in] ckp a checkpoint
+/// \return        `true` if the state has been restored correctly
+///
+/// Besides the base state, the symbols added by ARL and the training /
+/// validation examples (they're reshuffled by the validation strategy) are
+/// restored.
+///
+/// \remark
+/// Automatically defined symbols are identified by their opcode: the problem
+/// must be set up exactly as in the checkpointed search.
+///
+template<class T, template<class> class ES>
+bool src_search<T, ES>::load_checkpoint(const checkpoint &ckp)
+{
+  auto in_adts(ckp.get("adts"));
+  std::size_t n;
+  if (!(in_adts >> n))
+    return false;
+
+  for (std::size_t i(0); i < n; ++i)
+  {
+    opcode_t opcode;
+    i_mep code;
+    if (!(in_adts >> opcode) || !code.load(in_adts, prob().sset))
+      return false;
+
+    if (const auto *s = prob().sset.decode(opcode))
+    {
+      if (!s->auto_defined())
+        return false;
+    }
+    else if (prob().sset.insert(std::make_unique<adt>(code))->opcode()
+             != opcode)
+      return false;
+  }
+
+  auto in_training(ckp.get("training"));
+  auto in_validation(ckp.get("validation"));
+  if (!training_data().load_examples(in_training)
+      || !validation_data().load_examples(in_validation))
+    return false;
+
+  return search<T, ES>::load_checkpoint(ckp);
+}
+
+///
+/// Saves the state of the search into a checkpoint.
+///
+/// \param[out] ckp a checkpoint
+/// \return         `true` if the state has been saved correctly
+///
+/// \see load_checkpoint
+///
+template<class T, template<class> class ES>
+bool src_search<T, ES>::save_checkpoint(checkpoint *ckp) const
+{
+  const auto adts(prob().sset.adts());
+
+  std::ostringstream out_adts;
+  out_adts << adts.size() << '\n';
+  for (const auto *s : adts)
+  {
+    const auto *a(dynamic_cast<const adt *>(s));
+    if (!a)
+      return false;
+
+    out_adts << a->opcode() << '\n';
+    if (!a->code().save(out_adts))
+      return false;
+  }
+  ckp->set("adts", out_adts.str());
+
+  std::ostringstream out_training, out_validation;
+  if (!training_data().save_examples(out_training)
+      || !validation_data().save_examples(out_validation))
+    return false;
+  ckp->set("training", out_training.str());
+  ckp->set("validation", out_validation.str());
+
+  return search<T, ES>::save_checkpoint(ckp);
+}
+
 ///
 /// Calculates various performance metrics.
 ///
@@ -502,6 +612,7 @@ src_search<T, ES> &src_search<T, ES>::evaluator(evaluator_id id,
     }
   }
 
+  eva_tag = std::to_string(as_integer(id)) + ':' + msg;
   return *this;
 }
 
@@ -10,6 +10,8 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
+#include <sstream>
+
 #include "kernel/symbol_set.h"
 #include "kernel/adf.h"
 #include "kernel/argument.h"
@@ -78,12 +80,22 @@ std::vector<const symbol *> symbol_set::adts() const
 /// A symbol with undefined category will be changed to the first free
 /// category.
 ///
+/// \exception std::invalid_argument the arity of `s` exceeds the number of
+///                                   arguments a gene can store
+///
 symbol *symbol_set::insert(std::unique_ptr<symbol> s, double wr)
 {
   Expects(s);
   Expects(s->debug());
   Expects(wr >= 0.0);
 
+  // Genes have a fixed number of argument slots (`gene::k_args`): this is a
+  // configuration error and must be reported in release builds too.
+  if (s->arity() > gene::k_args)
+    throw std::invalid_argument("Symbol " + s->name()
+                                + " has too many arguments (max "
+                                + std::to_string(gene::k_args) + ")");
+
   const auto w(static_cast<weight_t>(wr * w_symbol::base_weight));
   const w_symbol ws(s.get(), w);
 
@@ -129,6 +141,8 @@ void symbol_set::collection::sum_container::scale_weights(double ratio, F f)
       s.weight *= ratio;
       sum_ += s.weight;
     }
+
+  build_alias_table();
 }
 
 ///
@@ -334,6 +348,55 @@ symbol_set::weight_t symbol_set::weight(const symbol &s) const
   return 0;
 }
 
+///
+/// Loads the weights of the symbols.
+///
+/// \param[in] in input stream
+/// \return       `true` if the weights have been loaded correctly
+///
+/// Symbols aren't created: the symbol set must already contain the same
+/// symbols (same opcodes, inserted in the same order) of the saved one.
+///
+/// \note
+/// If the load operation isn't successful the current object isn't changed.
+///
+bool symbol_set::load(std::istream &in)
+{
+  std::size_t n;
+  if (!(in >> n) || n != views_.size())
+    return false;
+
+  auto t_views(views_);
+  for (auto &v : t_views)
+    if (!v.all.load(in) || !v.functions.load(in) || !v.terminals.load(in)
+        || !v.adf.load(in) || !v.adt.load(in))
+      return false;
+
+  views_ = t_views;
+  return true;
+}
+
+///
+/// Saves the weights of the symbols.
+///
+/// \param[out] out output stream
+/// \return         `true` if the weights have been saved correctly
+///
+/// Weights change during the search (see `scale_adf_weights`) and are part
+/// of its state. Symbols are identified by their opcode.
+///
+bool symbol_set::save(std::ostream &out) const
+{
+  out << views_.size() << '\n';
+
+  for (const auto &v : views_)
+    if (!v.all.save(out) || !v.functions.save(out) || !v.terminals.save(out)
+        || !v.adf.save(out) || !v.adt.save(out))
+      return false;
+
+  return out.good();
+}
+
 ///
 /// Prints the symbol set to an output stream.
 ///
@@ -369,6 +432,40 @@ std::ostream &operator<<(std::ostream &o, const symbol_set &ss)
   return o;
 }
 
+///
+/// \return a hash of the symbols of the set
+///
+/// Every symbol contributes its name, opcode, categories and parametric flag.
+/// Names and opcodes of automatically defined symbols don't identify their
+/// code, so the signature of the code is added too. Weights (changed during
+/// the search) aren't considered.
+///
+hash_t symbol_set::fingerprint() const
+{
+  std::ostringstream ss;
+
+  for (const auto &s : symbols_)
+  {
+    ss << s->name() << ' ' << s->opcode() << ' ' << s->category();
+
+    const auto arity(s->arity());
+    for (auto j(decltype(arity){0}); j < arity; ++j)
+      ss << ' ' << function::cast(s.get())->arg_category(j);
+
+    ss << ' ' << (s->terminal() && terminal::cast(s.get())->parametric());
+
+    if (const auto *f = dynamic_cast<const adf *>(s.get()))
+      ss << ' ' << f->code().signature();
+    else if (const auto *t = dynamic_cast<const adt *>(s.get()))
+      ss << ' ' << t->code().signature();
+
+    ss << '\n';
+  }
+
+  const auto str(ss.str());
+  return murmurhash3::hash128(str.data(), str.size());
+}
+
 ///
 /// \return `true` if the object passes the internal consistency check
 ///
@@ -499,16 +596,113 @@ bool symbol_set::collection::debug() const
 ///
 /// \param[in] ws a weighted symbol
 ///
-/// We manage to sort the symbols in descending order, with respect to the
-/// weight, so the selection algorithm would run faster.
-///
 void symbol_set::collection::sum_container::insert(const w_symbol &ws)
 {
   elems_.push_back(ws);
   sum_ += ws.weight;
 
-  std::sort(begin(), end(),
-            [](auto s1, auto s2) { return s1.weight > s2.weight; });
+  build_alias_table();
+}
+
+///
+/// Loads the weights of the symbols in the container.
+///
+/// \param[in] in input stream
+/// \return       `true` if the weights have been loaded correctly
+///
+bool symbol_set::collection::sum_container::load(std::istream &in)
+{
+  std::size_t n;
+  if (!(in >> n) || n != size())
+    return false;
+
+  auto t_elems(elems_);
+  weight_t t_sum(0);
+
+  for (auto &ws : t_elems)
+  {
+    opcode_t opcode;
+    if (!(in >> opcode >> ws.weight) || opcode != ws.sym->opcode())
+      return false;
+
+    t_sum += ws.weight;
+  }
+
+  elems_ = t_elems;
+  sum_ = t_sum;
+  build_alias_table();
+
+  return true;
+}
+
+///
+/// Saves the weights of the symbols in the container.
+///
+/// \param[out] out output stream
+/// \return         `true` if the weights have been saved correctly
+///
+bool symbol_set::collection::sum_container::save(std::ostream &out) const
+{
+  out << size();
+  for (const auto &ws : elems_)
+    out << ' ' << ws.sym->opcode() << ' ' << ws.weight;
+  out << '\n';
+
+  return out.good();
+}
+
+///
+/// Builds the alias table used by the roulette method.
+///
+/// This is the Vose's variant of the Walker's alias method working on integer
+/// weights (so it's exact: no rounding errors). Every column of the table has
+/// the same probability of being selected and contains at most two symbols.
+///
+/// \see
+/// * "A Linear Algorithm For Generating Random Numbers With a Given
+///   Distribution" (Michael D. Vose)
+/// * <https://www.keithschwarz.com/darts-dice-coins/>
+///
+void symbol_set::collection::sum_container::build_alias_table()
+{
+  const auto n(elems_.size());
+
+  alias_.assign(n, {sum_, 0});
+  if (!sum_)
+    return;
+
+  // Weights are scaled by `n` so that the average weight is exactly `sum_`.
+  std::vector<std::uint64_t> scaled(n);
+  std::vector<std::size_t> small, large;
+
+  for (std::size_t i(0); i < n; ++i)
+  {
+    scaled[i] = static_cast<std::uint64_t>(elems_[i].weight) * n;
+
+    if (scaled[i] < sum_)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty())
+  {
+    const auto l(small.back());
+    small.pop_back();
+    const auto g(large.back());
+
+    alias_[l] = {static_cast<weight_t>(scaled[l]), g};
+
+    scaled[g] -= sum_ - scaled[l];
+    if (scaled[g] < sum_)
+    {
+      large.pop_back();
+      small.push_back(g);
+    }
+  }
+
+  // Remaining columns are full (they already have the `{sum_, ...}` value).
+  assert(small.empty());
 }
 
 ///
@@ -522,24 +716,22 @@ void symbol_set::collection::sum_container::insert(const w_symbol &ws)
 ///
 /// Two fast methods are described in "Fast Generation of Discrete Random
 /// Variables" (Marsaglia, Tsang, Wang).
-/// Also `std::discrete_distribution` seems quite fast.
 ///
-/// Anyway we choose the "roulette algorithm" because it's very simple.
+/// We use the alias method: constant time regardless of the number of
+/// symbols (important with wide datasets where every column is a terminal).
 ///
 const symbol &symbol_set::collection::sum_container::roulette() const
 {
   Expects(sum());
+  assert(alias_.size() == elems_.size());
 
-  const auto slot(random::sup(sum()));
+  const auto i(random::sup(elems_.size()));
+  const auto &column(alias_[i]);
 
-  std::size_t i(0);
-  for (auto wedge(elems_[i].weight);
-       wedge <= slot;
-       wedge += elems_[++i].weight)
-  {}
+  if (random::sup(sum()) < column.threshold)
+    return *elems_[i].sym;
 
-  assert(i < elems_.size());
-  return *elems_[i].sym;
+  return *elems_[column.alias].sym;
 
   // The so called roulette-wheel selection via stochastic acceptance:
   //
@@ -553,23 +745,8 @@ const symbol &symbol_set::collection::sum_container::roulette() const
   //
   // Internal tests have proved this is slower for Vita.
 
-  // This is a different approach from Eli Bendersky
-  // (<http://eli.thegreenplace.net/>):
-  //
-  //     weight_t total(0);
-  //     std::size_t winner(0);
-  //
-  //     for (std::size_t i(0); i < size(); ++i)
-  //     {
-  //       total += elems[i].weight;
-  //       if (random::sup(total + 1) < elems[i].weight)
-  //         winner = i;
-  //     }
-  //     return *elems[winner].sym;
-  //
-  // The interesting property of this algorithm is that you don't need to
-  // know the sum of weights in advance in order to use it. The method is
-  // cool, but slower than the standard roulette.
+  // The standard roulette (linear scan over the cumulative weights) is
+  // simpler but `O(n)`.
 }
 
 ///
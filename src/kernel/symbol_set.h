@@ -15,6 +15,7 @@
 
 #include <string>
 
+#include "kernel/cache_hash.h"
 #include "kernel/function.h"
 #include "kernel/range.h"
 #include "kernel/terminal.h"
@@ -64,8 +65,13 @@ public:
   weight_t weight(const symbol &) const;
 
   bool enough_terminals() const;
+  hash_t fingerprint() const;
   bool debug() const;
 
+  // Serialization (only weights).
+  bool load(std::istream &);
+  bool save(std::ostream &) const;
+
   friend std::ostream &operator<<(std::ostream &, const symbol_set &);
 
 private:
@@ -113,7 +119,7 @@ private:
       using const_iterator = sum_container_t::const_iterator;
 
       explicit sum_container(std::string n)
-        : elems_(), sum_(0), name_(std::move(n))
+        : elems_(), sum_(0), alias_(), name_(std::move(n))
       {
         Expects(!name_.empty());
       }
@@ -135,12 +141,28 @@ private:
 
       bool debug() const;
 
+      bool load(std::istream &);
+      bool save(std::ostream &) const;
+
     private:
+      void build_alias_table();
+
       sum_container_t elems_;
 
       // Sum of the weights of the symbols in the container.
       weight_t sum_;
 
+      // Alias table (Walker / Vose) used by the roulette. `alias_[i]` is
+      // associated with `elems_[i]`: column `i` returns `elems_[i]` if a
+      // random number in `[0;sum_[` is less than `threshold`, otherwise the
+      // `elems_[alias]` element. Rebuilt every time weights change.
+      struct alias_slot
+      {
+        weight_t    threshold;
+        std::size_t     alias;
+      };
+      std::vector<alias_slot> alias_;
+
       std::string name_;
     };
 
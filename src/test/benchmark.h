@@ -0,0 +1,250 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(BENCHMARK_H)
+#define      BENCHMARK_H
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kernel/distribution.h"
+#include "kernel/random.h"
+
+///
+/// Prevents the compiler from optimizing away the computation of `v`.
+///
+template<class T>
+void do_not_optimize(const T &v)
+{
+#if defined(__GNUC__)
+  asm volatile("" : : "g"(&v) : "memory");
+#else
+  static const void *volatile sink;
+  sink = &v;
+#endif
+}
+
+///
+/// A synthetic dataset in CSV format.
+///
+/// \param[in] rows           number of examples
+/// \param[in] width          number of input variables
+/// \param[in] classification kind of task
+/// \return                   the dataset (one example per line)
+///
+/// Inputs are uniformly distributed in `[-10, 10[`. The first column is the
+/// output: a simple polynomial of the inputs for symbolic regression, a class
+/// label (`"a"` / `"b"`, the sign of the polynomial) for classification.
+///
+inline std::string synthetic_csv(unsigned rows, unsigned width,
+                                 bool classification)
+{
+  std::ostringstream ss;
+  std::vector<double> x(width);
+
+  for (unsigned r(0); r < rows; ++r)
+  {
+    for (auto &xi : x)
+      xi = vita::random::between(-10.0, 10.0);
+
+    double y(x.front() * x.back());
+    for (unsigned i(0); i < width; ++i)
+      y += i % 2 ? -x[i] : x[i];
+
+    if (classification)
+      ss << (y > 0.0 ? "\"a\"" : "\"b\"");
+    else
+      ss << y;
+
+    for (const auto xi : x)
+      ss << ',' << xi;
+    ss << '\n';
+  }
+
+  return ss.str();
+}
+
+///
+/// A minimal microbenchmark harness.
+///
+/// Every benchmark is a function executed `iterations` times in a tight loop.
+/// The loop is repeated `warm_up` times without measuring (to fill caches,
+/// memory pools, branch predictors...) and then `repetitions` times. The
+/// statistical summary refers to the time of a single iteration.
+///
+/// Results can be written in JSON format and compared against a baseline
+/// (a JSON file previously written by the same harness).
+///
+class benchmark
+{
+public:
+  struct result
+  {
+    std::string name;
+    unsigned iterations;
+    vita::distribution<double> ns;  // nanoseconds per iteration
+  };
+
+  /// Baseline median (nanoseconds per iteration) indexed by benchmark name.
+  using baseline_t = std::map<std::string, double>;
+
+  explicit benchmark(unsigned reps = 15, unsigned warm = 3,
+                     std::string filter = "")
+    : repetitions_(reps), warm_up_(warm), filter_(std::move(filter))
+  {
+  }
+
+  ///
+  /// \param[in] name       identifier of the benchmark
+  /// \param[in] iterations calls of `f` per repetition
+  /// \param[in] f          the function to be measured (it receives the
+  ///                       index of the iteration)
+  /// \param[in] setup      an optional function called, without measuring,
+  ///                       before every repetition
+  ///
+  template<class F, class S = void (*)()>
+  void run(const std::string &name, unsigned iterations, F f,
+           S setup = [] {})
+  {
+    if (name.find(filter_) == std::string::npos)
+      return;
+
+    result r{name, iterations, {}};
+
+    for (unsigned rep(0); rep < warm_up_ + repetitions_; ++rep)
+    {
+      setup();
+
+      const auto start(std::chrono::steady_clock::now());
+      for (unsigned i(0); i < iterations; ++i)
+        if constexpr (std::is_void_v<decltype(f(i))>)
+          f(i);
+        else
+          do_not_optimize(f(i));
+      const std::chrono::duration<double, std::nano> elapsed(
+        std::chrono::steady_clock::now() - start);
+
+      if (rep >= warm_up_)
+        r.ns.add(elapsed.count() / iterations);
+    }
+
+    std::cout << std::left << std::setw(32) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << r.ns.quantile(0.5) << " ns  (+/- "
+              << r.ns.standard_deviation() << ")\n";
+
+    results_.push_back(r);
+  }
+
+  ///
+  /// \param[out] o output stream
+  ///
+  /// One benchmark per line: the format is simple enough to be parsed by
+  /// `read_baseline`.
+  ///
+  void write_json(std::ostream &o) const
+  {
+    o << "{\n  \"unit\": \"ns\",\n  \"benchmarks\": [\n" << std::fixed
+      << std::setprecision(3);
+
+    for (std::size_t i(0); i < results_.size(); ++i)
+    {
+      const auto &r(results_[i]);
+
+      o << "    {\"name\":\"" << r.name << "\""
+        << ",\"iterations\":" << r.iterations
+        << ",\"repetitions\":" << r.ns.count()
+        << ",\"min\":" << r.ns.min()
+        << ",\"median\":" << r.ns.quantile(0.5)
+        << ",\"mean\":" << r.ns.mean()
+        << ",\"stddev\":" << r.ns.standard_deviation()
+        << ",\"max\":" << r.ns.max() << '}'
+        << (i + 1 < results_.size() ? ",\n" : "\n");
+    }
+
+    o << "  ]\n}\n";
+  }
+
+  ///
+  /// \param[in] i input stream containing the output of `write_json`
+  /// \return      the median of every benchmark
+  ///
+  static baseline_t read_baseline(std::istream &i)
+  {
+    const auto field([](const std::string &line, const std::string &key)
+    {
+      const auto p(line.find("\"" + key + "\":"));
+      return p == std::string::npos ? std::string()
+                                    : line.substr(p + key.length() + 3);
+    });
+
+    baseline_t ret;
+
+    for (std::string line; std::getline(i, line);)
+    {
+      const auto name(field(line, "name"));
+      const auto median(field(line, "median"));
+
+      if (name.length() > 1 && !median.empty())
+        ret[name.substr(1, name.find('"', 1) - 1)] = std::stod(median);
+    }
+
+    return ret;
+  }
+
+  ///
+  /// \param[in]  b         a baseline
+  /// \param[in]  tolerance accepted relative slowdown (e.g. `0.1` for 10%)
+  /// \param[out] o         output stream for the comparison table
+  /// \return               number of benchmarks slower than the baseline
+  ///                       by more than `tolerance`
+  ///
+  unsigned compare(const baseline_t &b, double tolerance,
+                   std::ostream &o) const
+  {
+    unsigned regressions(0);
+
+    for (const auto &r : results_)
+      if (const auto it = b.find(r.name); it != b.end() && it->second > 0.0)
+      {
+        const auto delta(r.ns.quantile(0.5) / it->second - 1.0);
+        const bool slower(delta > tolerance);
+
+        o << std::left << std::setw(32) << r.name << std::right
+          << std::showpos << std::fixed << std::setprecision(1)
+          << std::setw(8) << 100.0 * delta << '%' << std::noshowpos
+          << (slower ? "  REGRESSION" : "") << '\n';
+
+        if (slower)
+          ++regressions;
+      }
+
+    return regressions;
+  }
+
+private:
+  std::vector<result> results_;
+
+  unsigned repetitions_;
+  unsigned warm_up_;
+  std::string filter_;
+};
+
+#endif  // include guard
@@ -11,15 +11,21 @@
  */
 
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <sstream>
+#include <thread>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "third_party/doctest/doctest.h"
 
+#include "kernel/adf.h"
 #include "kernel/cache.h"
 #include "kernel/i_mep.h"
 #include "kernel/interpreter.h"
 #include "kernel/problem.h"
+#include "kernel/shared_cache.h"
+#include "kernel/src/search.h"
 #include "kernel/src/primitive/factory.h"
 
 #include "test/fixture2.h"
@@ -176,6 +182,220 @@ TEST_CASE_FIXTURE(fixture2, "Serialization")
     }
 }
 
+TEST_CASE("Serialization integrity")
+{
+  using namespace vita;
+
+  vita::cache cache1(10), cache2(10);
+
+  const hash_t h1(1, 2), h2(3, 4), h3(5, 6);
+  cache1.insert(h1, {1.0});
+  cache1.insert(h2, {2.0, 3.0});
+  cache1.clear();  // `h1` and `h2` are no longer valid
+  cache1.insert(h3, {4.0});
+
+  std::stringstream ss;
+  CHECK(cache1.save(ss));
+  const std::string saved(ss.str());
+
+  CHECK(cache2.load(ss));
+  CHECK(!cache2.find(h1).size());
+  CHECK(!cache2.find(h2).size());
+  CHECK(cache2.find(h3) == fitness_t{4.0});
+
+  // Corrupted data is detected and the cache isn't changed.
+  std::string corrupted(saved);
+  corrupted[corrupted.size() / 2] ^= 0x10;
+  std::istringstream in1(corrupted);
+  CHECK(!cache2.load(in1));
+  CHECK(cache2.find(h3) == fitness_t{4.0});
+
+  // Same for truncated data (at any point).
+  for (std::size_t len(0); len < saved.size(); ++len)
+  {
+    std::istringstream in2(saved.substr(0, len));
+    CHECK(!cache2.load(in2));
+  }
+  CHECK(cache2.find(h3) == fitness_t{4.0});
+}
+
+TEST_CASE("Shared cache")
+{
+  using namespace vita;
+
+  const auto dir(std::filesystem::temp_directory_path()
+                 / "vita_shared_cache");
+  std::filesystem::remove_all(dir);  // possible leftovers of previous tests
+  std::filesystem::create_directories(dir);
+
+  const hash_t key(1, 2);
+  const unsigned n(1000);
+
+  shared_cache c1, c2, c3;
+  CHECK(!c1.attached());
+  CHECK(!c1.find(hash_t(1, 1)).size());
+
+  REQUIRE(c1.attach(dir, 12, key));
+  REQUIRE(c2.attach(dir, 12, key));
+  CHECK(c1.attached());
+  CHECK(std::filesystem::exists(dir / shared_cache::file_name(12, key)));
+
+  for (unsigned i(1); i <= n; ++i)
+    c1.insert(hash_t(i, i + 1), {double(i), -double(i)});
+
+  // Values inserted by `c1` are seen by `c2`.
+  for (unsigned i(1); i <= n; ++i)
+    CHECK(c2.find(hash_t(i, i + 1)) == fitness_t{double(i), -double(i)});
+  CHECK(!c2.find(hash_t(1, 3)).size());
+
+  // A distinct key maps to a distinct file.
+  REQUIRE(c3.attach(dir, 12, hash_t(3, 4)));
+  for (unsigned i(1); i <= n; ++i)
+    CHECK(!c3.find(hash_t(i, i + 1)).size());
+
+  // Too large fitnesses are skipped.
+  c1.insert(hash_t(1, 2),
+            fitness_t(with_size(shared_cache::max_fitness_size + 1), 0.0));
+  CHECK(c2.find(hash_t(1, 2)) == fitness_t{1.0, -1.0});
+
+  // A detached cache doesn't see anything but the file is still there.
+  c1.detach();
+  CHECK(!c1.attached());
+  CHECK(!c1.find(hash_t(1, 2)).size());
+  CHECK(c2.find(hash_t(1, 2)) == fitness_t{1.0, -1.0});
+
+  // Concurrent writers / readers on a small table: an entry is either missing
+  // or complete.
+  shared_cache small;
+  REQUIRE(small.attach(dir, 4, key));
+
+  std::vector<std::thread> workers;
+  std::atomic<unsigned> torn(0);
+  for (unsigned t(0); t < 4; ++t)
+    workers.emplace_back([&, t]
+                         {
+                           shared_cache c;
+                           if (!c.attach(dir, 4, key))
+                             return;
+
+                           for (unsigned i(1); i <= 20000; ++i)
+                           {
+                             const double v(i % 64 + 1);
+                             const hash_t h(i % 64, i % 64 + 1);
+                             if (t % 2)
+                               c.insert(h, {v, v, v, v});
+                             else if (const auto f = c.find(h);
+                                      f.size() && f != fitness_t{v, v, v, v})
+                               ++torn;
+                           }
+                         });
+  for (auto &w : workers)
+    w.join();
+  CHECK(torn == 0);
+
+  // A file with a mismatching header is rejected.
+  {
+    std::fstream f(dir / shared_cache::file_name(12, key),
+                   std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(8);
+    f.put('\x7f');
+  }
+  CHECK(!c1.attach(dir, 12, key));
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Cache key")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lWARNING;
+
+  const auto dir(std::filesystem::temp_directory_path()
+                 / "vita_shared_cache_key");
+  std::filesystem::remove_all(dir);  // possible leftovers of previous tests
+  std::filesystem::create_directories(dir);
+
+  const auto files([&dir]
+                   {
+                     return std::distance(
+                       std::filesystem::directory_iterator(dir),
+                       std::filesystem::directory_iterator());
+                   });
+
+  // Two problems with the same data and symbols (opcodes aside). ARL adds a
+  // single ADT to each of them but with a different code.
+  src_problem prob1("./test_resources/mep.csv", src_problem::default_symbols);
+  src_problem prob2("./test_resources/mep.csv", src_problem::default_symbols);
+  REQUIRE(!!prob1);
+  REQUIRE(!!prob2);
+
+  for (auto *p : {&prob1, &prob2})
+  {
+    p->env.init().mep.code_length = 32;
+    p->env.individuals = 10;
+    p->env.generations = 1;
+    p->env.misc.shared_cache_dir = dir.string();
+  }
+
+  const auto block([](const src_problem &p)
+                   {
+                     i_mep ret(p);
+                     while (ret.active_symbols() < 2)
+                       ret = i_mep(p);
+                     return ret;
+                   });
+
+  prob1.sset.insert(std::make_unique<adt>(block(prob1)));
+  prob2.sset.insert(std::make_unique<adt>(block(prob2)));
+
+  // The key of the shared cache depends on the code of the ADTs...
+  src_search<>(prob1).run(1);
+  CHECK(files() == 1);
+  src_search<>(prob2).run(1);
+  CHECK(files() == 2);
+
+  // ... but not on the weights of the symbols (they change during the
+  // search without affecting the fitness).
+  prob1.sset.scale_adf_weights();
+  src_search<>(prob1).run(1);
+  CHECK(files() == 2);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Shared cache and DSS")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lWARNING;
+
+  const auto dir(std::filesystem::temp_directory_path()
+                 / "vita_shared_cache_dss");
+  std::filesystem::remove_all(dir);  // possible leftovers of previous tests
+  std::filesystem::create_directories(dir);
+
+  src_problem prob("./test_resources/mep.csv", src_problem::default_symbols);
+  REQUIRE(!!prob);
+
+  prob.env.individuals = 30;
+  prob.env.generations = 20;
+  prob.env.dss = 3;
+  prob.env.misc.shared_cache_dir = dir.string();
+
+  src_search<> s(prob);
+  s.validation_strategy(validator_id::dss);
+
+  // Sharing restarts after every shake with a key matching the new subset.
+  s.run(1);
+
+  const auto files(std::distance(std::filesystem::directory_iterator(dir),
+                                 std::filesystem::directory_iterator()));
+  CHECK(files > 1);
+
+  std::filesystem::remove_all(dir);
+}
+
 TEST_CASE("Type hash_t")
 {
   const vita::hash_t empty;
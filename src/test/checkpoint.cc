@@ -0,0 +1,167 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <filesystem>
+#include <fstream>
+
+#include "kernel/checkpoint.h"
+#include "kernel/src/search.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+TEST_SUITE("CHECKPOINT")
+{
+
+TEST_CASE("Container")
+{
+  using namespace vita;
+
+  const auto path(std::filesystem::temp_directory_path()
+                  / "vita_checkpoint_container");
+
+  checkpoint c1;
+  CHECK(c1.empty());
+
+  c1.set("alpha", "first section");
+  c1.set("beta", std::string("binary\0content", 14));
+  c1.set("empty", "");
+  CHECK(!c1.empty());
+  REQUIRE(c1.save(path));
+
+  checkpoint c2;
+  REQUIRE(c2.load(path));
+  CHECK(c2.has("alpha"));
+  CHECK(c2.has("beta"));
+  CHECK(c2.has("empty"));
+  CHECK(!c2.has("gamma"));
+  CHECK(c2.get("alpha").str() == "first section");
+  CHECK(c2.get("beta").str() == std::string("binary\0content", 14));
+  CHECK(c2.get("empty").str().empty());
+
+  // A corrupted file is rejected and the current content isn't changed.
+  {
+    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(20);
+    f.put('\xff');
+  }
+
+  c2.clear();
+  c2.set("gamma", "untouched");
+  CHECK(!c2.load(path));
+  CHECK(c2.has("gamma"));
+  CHECK(!c2.has("alpha"));
+
+  // Saving again keeps the replaced checkpoint aside.
+  const auto prev(checkpoint::previous(path));
+  std::filesystem::remove(prev);
+  std::filesystem::remove(path);
+
+  REQUIRE(c1.save(path));
+  CHECK(!std::filesystem::exists(prev));
+  c2.set("alpha", "second version");
+  REQUIRE(c2.save(path));
+  REQUIRE(std::filesystem::exists(prev));
+
+  checkpoint c3;
+  REQUIRE(c3.load(prev));
+  CHECK(c3.get("alpha").str() == "first section");
+  REQUIRE(c3.load(path));
+  CHECK(c3.get("alpha").str() == "second version");
+
+  // A failed save doesn't touch the existing files.
+  CHECK(!c1.save(path / "missing_dir"));
+  REQUIRE(c3.load(path));
+  CHECK(c3.get("alpha").str() == "second version");
+
+  std::filesystem::remove(prev);
+  std::filesystem::remove(path);
+  CHECK(!c2.load(path));
+}
+
+TEST_CASE("Resume")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lWARNING;
+
+  const auto path(std::filesystem::temp_directory_path()
+                  / "vita_checkpoint_search");
+  auto saved(path);
+  saved += ".gen9";
+  // Possible leftovers of previous tests.
+  std::filesystem::remove(path);
+  std::filesystem::remove(checkpoint::previous(path));
+
+  src_problem prob("./test_resources/mep.csv", src_problem::default_symbols);
+  REQUIRE(!!prob);
+
+  prob.env.individuals = 30;
+  prob.env.generations = 20;
+  prob.env.dss = 3;
+  prob.env.misc.checkpoint_file = path.string();
+  prob.env.misc.checkpoint_interval = 1;
+
+  // Uninterrupted search (two runs). The checkpoint written at the end of
+  // generation `9` of the first run is set aside to simulate a crash.
+  std::vector<fitness_t> trajectory1;
+  src_search<> s1(prob);
+  s1.validation_strategy(validator_id::dss);
+  s1.after_generation([&](const population<i_mep> &, const summary<i_mep> &s)
+                      {
+                        trajectory1.push_back(s.best.score.fitness);
+                        if (trajectory1.size() == 10)
+                          std::filesystem::copy_file(
+                            path, saved,
+                            std::filesystem::copy_options::overwrite_existing);
+                      });
+
+  random::seed(20200101);
+  const auto sum1(s1.run(2));
+
+  // A completed search removes its checkpoint.
+  CHECK(!std::filesystem::exists(path));
+  CHECK(!std::filesystem::exists(checkpoint::previous(path)));
+  REQUIRE(std::filesystem::exists(saved));
+  REQUIRE(trajectory1.size() > 10);
+
+  // Resumed search. The last checkpoint is corrupted (e.g. a crash while
+  // the data were still in the page cache) and the previous one is used.
+  std::filesystem::rename(saved, checkpoint::previous(path));
+  {
+    std::ofstream garbage(path, std::ios::binary);
+    garbage << "VITACKPT truncated";
+  }
+
+  std::vector<fitness_t> trajectory2;
+  src_search<> s2(prob);
+  s2.validation_strategy(validator_id::dss);
+  s2.after_generation([&](const population<i_mep> &, const summary<i_mep> &s)
+                      {
+                        trajectory2.push_back(s.best.score.fitness);
+                      });
+
+  random::seed(1);  // the state of the engine comes from the checkpoint
+  const auto sum2(s2.run(2));
+
+  CHECK(!std::filesystem::exists(path));
+  CHECK(!std::filesystem::exists(checkpoint::previous(path)));
+  REQUIRE(trajectory2.size() + 10 == trajectory1.size());
+  CHECK(std::equal(trajectory2.begin(), trajectory2.end(),
+                   std::next(trajectory1.begin(), 10)));
+
+  CHECK(sum2.best.solution == sum1.best.solution);
+  CHECK(sum2.best.score.fitness == sum1.best.score.fitness);
+  CHECK(sum2.gen == sum1.gen);
+}
+
+}  // TEST_SUITE("CHECKPOINT")
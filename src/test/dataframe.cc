@@ -11,6 +11,8 @@
  */
 
 #include <cstdlib>
+#include <iterator>
+#include <utility>
 
 #include "kernel/random.h"
 #include "kernel/src/dataframe.h"
@@ -54,4 +56,34 @@ TEST_CASE("load_csv")
   CHECK(10 * n <= 11 * half);
 }
 
+TEST_CASE("Fingerprint")
+{
+  using namespace vita;
+
+  dataframe d1, d2;
+  REQUIRE(d1.read("./test_resources/mep.csv"));
+  REQUIRE(d2.read("./test_resources/mep.csv"));
+  CHECK(d1.fingerprint() == d2.fingerprint());
+
+  // Difficulty and age don't matter...
+  for (auto &e : d2)
+  {
+    e.difficulty += 10;
+    ++e.age;
+  }
+  CHECK(d1.fingerprint() == d2.fingerprint());
+
+  // ... inputs, outputs and order of the examples do.
+  std::swap(*d2.begin(), *std::next(d2.begin()));
+  CHECK(d1.fingerprint() != d2.fingerprint());
+  std::swap(*d2.begin(), *std::next(d2.begin()));
+  REQUIRE(d1.fingerprint() == d2.fingerprint());
+
+  d2.begin()->output = std::get<D_DOUBLE>(d2.begin()->output) + 1.0;
+  CHECK(d1.fingerprint() != d2.fingerprint());
+
+  d2.clear();
+  CHECK(d1.fingerprint() != d2.fingerprint());
+}
+
 }  // TEST_SUITE("DATAFRAME")
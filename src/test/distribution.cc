@@ -0,0 +1,119 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cmath>
+#include <sstream>
+
+#include "kernel/distribution.h"
+#include "kernel/random.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+TEST_SUITE("DISTRIBUTION")
+{
+
+TEST_CASE("Exact histogram")
+{
+  using namespace vita;
+
+  distribution<double> d;
+  for (unsigned i(0); i < 1000; ++i)
+    d.add(i % 4);
+
+  CHECK(d.count() == 1000);
+  CHECK(d.seen().size() == 4);
+  CHECK(d.entropy() == doctest::Approx(2.0));
+
+  CHECK(d.quantile(0.0) == doctest::Approx(0.0));
+  CHECK(d.quantile(0.25) == doctest::Approx(0.0));
+  CHECK(d.quantile(0.5) == doctest::Approx(1.0));
+  CHECK(d.quantile(1.0) == doctest::Approx(3.0));
+}
+
+TEST_CASE("Bounded memory")
+{
+  using namespace vita;
+  using dist = distribution<double>;
+
+  dist d;
+  const unsigned n(200000);
+  for (unsigned i(0); i < n; ++i)
+    d.add(random::between(0.0, 1000.0));
+
+  CHECK(d.count() == n);
+  CHECK(d.seen().size() <= 2 * dist::max_bins);
+
+  std::uintmax_t total(0);
+  for (const auto &b : d.seen())
+    total += b.second;
+  CHECK(total == n);
+
+  // Quantiles of a uniform distribution have a known value.
+  const double eps(2.0 / dist::max_bins + 0.01);
+  for (const double q : {0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99})
+    CHECK(std::abs(d.quantile(q) / 1000.0 - q) <= eps);
+
+  CHECK(d.mean() == doctest::Approx(500.0).epsilon(0.01));
+
+  // Entropy is computed on the (bounded) histogram.
+  CHECK(d.entropy() > 0.0);
+  CHECK(d.entropy() <= std::log2(2.0 * dist::max_bins));
+
+  std::stringstream ss;
+  CHECK(d.save(ss));
+  dist d2;
+  CHECK(d2.load(ss));
+  CHECK(d2.seen() == d.seen());
+  CHECK(d2.quantile(0.5) == doctest::Approx(d.quantile(0.5)));
+}
+
+TEST_CASE("Merge")
+{
+  using namespace vita;
+
+  for (const unsigned n : {10u, 100u, 10000u})
+  {
+    distribution<double> all, d1, d2;
+
+    for (unsigned i(0); i < n; ++i)
+    {
+      const auto v(random::between(-100.0, 100.0));
+
+      all.add(v);
+      (random::boolean() ? d1 : d2).add(v);
+    }
+
+    distribution<double> empty;
+    d1.merge(empty);
+    empty.merge(d1);
+    CHECK(empty.count() == d1.count());
+
+    d1.merge(d2);
+
+    CHECK(d1.count() == all.count());
+    CHECK(d1.min() == doctest::Approx(all.min()));
+    CHECK(d1.max() == doctest::Approx(all.max()));
+    CHECK(d1.mean() == doctest::Approx(all.mean()));
+    CHECK(d1.variance() == doctest::Approx(all.variance()));
+
+    if (n < distribution<double>::max_bins)
+    {
+      CHECK(d1.seen() == all.seen());
+      CHECK(d1.entropy() == doctest::Approx(all.entropy()));
+    }
+    else
+      CHECK(d1.seen().size() <= 2 * distribution<double>::max_bins);
+  }
+}
+
+}  // TEST_SUITE("DISTRIBUTION")
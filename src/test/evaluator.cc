@@ -0,0 +1,307 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include "kernel/evaluator_pool.h"
+#include "kernel/evaluator_proxy.h"
+#include "kernel/i_mep.h"
+#include "kernel/team.h"
+#include "kernel/src/evaluator.h"
+#include "kernel/src/problem.h"
+
+#include "test/fixture1.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+// A slow (but interchangeable) evaluator keeping track of the concurrent
+// evaluations.
+class slow_evaluator : public vita::evaluator<vita::i_mep>
+{
+public:
+  vita::fitness_t operator()(const vita::i_mep &prg) override
+  {
+    const int n(++running);
+    for (int p(peak); n > p && !peak.compare_exchange_weak(p, n);)
+      ;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    --running;
+
+    if (prg.empty())
+      throw std::invalid_argument("Empty program");
+
+    return {-static_cast<double>(prg.signature().data[0] % 1000)};
+  }
+
+  inline static std::atomic<int> running{0}, peak{0};
+};
+
+TEST_SUITE("EVALUATOR")
+{
+
+TEST_CASE("Team member outputs")
+{
+  using namespace vita;
+
+  src_problem pr;
+  pr.env.init();
+  CHECK(pr.data().read("./test_resources/mep.csv") == 10);
+  pr.setup_symbols();
+
+  mse_evaluator<team<i_mep>> cached(pr.data());
+
+  // Reference value: the running average of the team members calculated by
+  // the team lambda function.
+  const auto reference([&](const team<i_mep> &t)
+  {
+    const reg_lambda_f<team<i_mep>> lambda(t);
+
+    double err(0.0), illegals(0.0);
+    unsigned n(0);
+
+    for (const auto &e : pr.data())
+    {
+      if (const auto res = lambda(e); has_value(res))
+      {
+        const auto delta(lexical_cast<D_DOUBLE>(res) - label_as<D_DOUBLE>(e));
+        err += delta * delta;
+      }
+      else
+        err += std::pow(100.0, ++illegals);
+
+      ++n;
+    }
+
+    return -err / n;
+  });
+
+  std::vector<i_mep> pool;
+  for (unsigned i(0); i < 8; ++i)
+    pool.emplace_back(pr);
+
+  // Teams share many members: most of the outputs are taken from the cache.
+  for (unsigned i(0); i < 1000; ++i)
+  {
+    const team<i_mep> t({random::element(pool), random::element(pool),
+                         random::element(pool)});
+
+    const auto f(cached(t));
+    CHECK(f[0] == doctest::Approx(reference(t)));
+
+    mse_evaluator<team<i_mep>> uncached(pr.data());
+    CHECK(f == uncached(t));
+
+    if (random::boolean(0.1))
+      cached.clear();
+  }
+}
+
+TEST_CASE_FIXTURE(fixture1, "Batch")
+{
+  using namespace vita;
+
+  std::vector<i_mep> pool;
+  for (unsigned i(0); i < 50; ++i)
+    pool.emplace_back(prob);
+
+  // Many duplicates.
+  std::vector<const i_mep *> prgs;
+  for (unsigned i(0); i < 200; ++i)
+    prgs.push_back(&random::element(pool));
+
+  test_evaluator<i_mep> eva(test_evaluator_type::distinct);
+  const auto f1(eva.batch(prgs));
+  REQUIRE(f1.size() == prgs.size());
+  for (std::size_t i(0); i < prgs.size(); ++i)
+    CHECK(f1[i] == eva(*prgs[i]));
+
+  evaluator_proxy<i_mep, test_evaluator<i_mep>> proxy(
+    test_evaluator<i_mep>(test_evaluator_type::distinct), 10);
+  CHECK(proxy.batch({}).empty());
+
+  const auto f2(proxy.batch(prgs));
+  REQUIRE(f2.size() == prgs.size());
+  for (std::size_t i(0); i < prgs.size(); ++i)
+  {
+    CHECK(f2[i] == proxy(*prgs[i]));
+
+    for (std::size_t j(0); j < i; ++j)
+      CHECK((f2[i] == f2[j])
+            == (prgs[i]->signature() == prgs[j]->signature()));
+  }
+
+  // Second round: everything comes from the cache.
+  CHECK(proxy.batch(prgs) == f2);
+}
+
+TEST_CASE_FIXTURE(fixture1, "Shared cache")
+{
+  using namespace vita;
+  using proxy_t = evaluator_proxy<i_mep, test_evaluator<i_mep>>;
+
+  const auto dir(std::filesystem::temp_directory_path()
+                 / "vita_shared_proxy");
+  std::filesystem::remove_all(dir);  // possible leftovers of previous tests
+  std::filesystem::create_directories(dir);
+
+  const unsigned bits(16);
+
+  // Individuals mapped to distinct slots of the shared table.
+  std::vector<i_mep> pool;
+  for (std::set<std::uint64_t> used; pool.size() < 50;)
+    if (i_mep prg(prob);
+        used.insert(prg.signature().data[0] & ((1u << bits) - 1)).second)
+      pool.push_back(prg);
+
+  std::vector<const i_mep *> prgs;
+  for (const auto &prg : pool)
+    prgs.push_back(&prg);
+
+  proxy_t p1(test_evaluator<i_mep>(test_evaluator_type::distinct), bits);
+  proxy_t p2(test_evaluator<i_mep>(test_evaluator_type::distinct), bits);
+  proxy_t p3(test_evaluator<i_mep>(test_evaluator_type::distinct), bits);
+
+  const hash_t key(1, 2);
+  REQUIRE(p1.share(dir, key));
+  REQUIRE(p2.share(dir, key));
+  REQUIRE(p3.share(dir, hash_t(3, 4)));
+
+  const auto f1(p1.batch(prgs));
+
+  // Evaluating in reverse order, the evaluator of `p2` would assign
+  // different values: they come from the shared cache.
+  for (std::size_t i(prgs.size()); i--;)
+    CHECK(p2(*prgs[i]) == f1[i]);
+  CHECK(p2.counters().cache_hits == prgs.size());
+
+  // A distinct key doesn't share anything.
+  const std::vector<const i_mep *> reversed(prgs.rbegin(), prgs.rend());
+  p3.batch(reversed);
+  CHECK(p3.counters().cache_hits == 0);
+
+  // Clearing the cache (the data has changed) stops sharing.
+  p2.clear();
+  const auto hits(p2.counters().cache_hits);
+  p2.batch(prgs);
+  CHECK(p2.counters().cache_hits == hits);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_CASE_FIXTURE(fixture1, "Asynchronous evaluation")
+{
+  using namespace vita;
+
+  std::vector<i_mep> prgs;
+  for (unsigned i(0); i < 20; ++i)
+    prgs.emplace_back(prob);
+
+  slow_evaluator reference;
+  std::vector<fitness_t> expected;
+  for (const auto &prg : prgs)
+    expected.push_back(reference(prg));
+
+  SUBCASE("Default implementation")
+  {
+    for (std::size_t i(0); i < prgs.size(); ++i)
+      CHECK(reference.async(prgs[i]).get() == expected[i]);
+  }
+
+  SUBCASE("Pool")
+  {
+    slow_evaluator::peak = 0;
+    evaluator_pool<i_mep, slow_evaluator> pool(
+      std::vector<slow_evaluator>(4));
+    CHECK(pool.size() == 4);
+
+    std::vector<std::future<fitness_t>> results;
+    for (const auto &prg : prgs)
+      results.push_back(pool.async(prg));
+
+    for (std::size_t i(0); i < prgs.size(); ++i)
+      CHECK(results[i].get() == expected[i]);
+    CHECK(slow_evaluator::peak > 1);
+    CHECK(slow_evaluator::peak <= 4);
+
+    std::vector<const i_mep *> ptrs;
+    for (const auto &prg : prgs)
+      ptrs.push_back(&prg);
+    CHECK(pool.batch(ptrs) == expected);
+
+    // Exceptions are propagated to the caller.
+    CHECK_THROWS_AS(pool(i_mep()), std::invalid_argument);
+    CHECK(pool(prgs.front()) == expected.front());
+  }
+
+  SUBCASE("Proxy")
+  {
+    evaluator_proxy<i_mep, evaluator_pool<i_mep, slow_evaluator>> proxy(
+      evaluator_pool<i_mep, slow_evaluator>(std::vector<slow_evaluator>(4)),
+      prob.env.cache_size);
+
+    std::vector<std::future<fitness_t>> results;
+    for (const auto &prg : prgs)
+      results.push_back(proxy.async(prg));
+    for (std::size_t i(0); i < prgs.size(); ++i)
+      CHECK(results[i].get() == expected[i]);
+    CHECK(proxy.counters().cache_hits == 0);
+
+    // Collected results are cached.
+    for (std::size_t i(0); i < prgs.size(); ++i)
+    {
+      auto f(proxy.async(prgs[i]));
+      CHECK(f.wait_for(std::chrono::seconds(0))
+            == std::future_status::ready);
+      CHECK(f.get() == expected[i]);
+    }
+    CHECK(proxy.counters().cache_hits == prgs.size());
+    CHECK(proxy.counters().evaluations == prgs.size());
+
+    // Behind a cache only the misses are evaluations.
+    metered_evaluator<i_mep> metered(proxy);
+    for (const auto &prg : prgs)
+      CHECK(metered.async(prg).get() == metered(prg));
+    CHECK(metered.counters().requests == 2 * prgs.size());
+    CHECK(metered.counters().evaluations == prgs.size());
+  }
+
+  SUBCASE("Metered")
+  {
+    metered_evaluator<i_mep> metered(reference);
+
+    auto f(metered.async(prgs.front()));
+    CHECK(metered.collect(prgs.front(), f) == expected.front());
+    CHECK(metered.counters().requests == 1);
+
+    // The collected result is remembered...
+    CHECK(metered(prgs.front()) == expected.front());
+    CHECK(metered.counters().requests == 1);
+
+    // ... until it's forgotten.
+    metered.forget();
+    CHECK(metered(prgs.front()) == expected.front());
+    CHECK(metered.counters().requests == 2);
+
+    // Without a cache every request is an evaluation.
+    CHECK(metered.counters().evaluations == 2);
+  }
+}
+
+}  // TEST_SUITE("EVALUATOR")
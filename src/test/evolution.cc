@@ -10,9 +10,16 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
+#include <atomic>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
+#include "kernel/evaluator_pool.h"
+#include "kernel/evaluator_proxy.h"
 #include "kernel/evolution.h"
 #include "kernel/i_mep.h"
 
@@ -21,6 +28,65 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "third_party/doctest/doctest.h"
 
+// Interchangeable evaluators with distinct latencies: the fitness only
+// depends on the individual, the evaluation time also on the evaluator.
+// Concurrent evaluations are counted.
+class latency_evaluator : public vita::evaluator<vita::i_mep>
+{
+public:
+  explicit latency_evaluator(unsigned us) : latency_(us) {}
+
+  vita::fitness_t operator()(const vita::i_mep &prg) override
+  {
+    const int n(++running);
+    for (int p(peak); n > p && !peak.compare_exchange_weak(p, n);)
+      ;
+
+    const auto h(prg.signature().data[0]);
+
+    std::this_thread::sleep_for(latency_ * (1 + h % 3));
+    --running;
+
+    return {-static_cast<double>(h % 1000)};
+  }
+
+  inline static std::atomic<int> running{0}, peak{0};
+
+private:
+  std::chrono::microseconds latency_;
+};
+
+template<template<class> class ES>
+vita::summary<vita::i_mep> in_flight_run(
+  vita::problem &prob, unsigned in_flight,
+  std::vector<latency_evaluator> evaluators)
+{
+  using namespace vita;
+
+  prob.env.evaluations_in_flight = in_flight;
+
+  random::seed(42);
+  // The cache leaves the evaluations of the offspring only.
+  using pool_t = evaluator_pool<i_mep, latency_evaluator>;
+  evaluator_proxy<i_mep, pool_t> eva(pool_t(std::move(evaluators)), 16);
+  evolution<i_mep, ES> evo(prob, eva);
+
+  // The initial population is evaluated in a single batch: concurrent
+  // evaluations are monitored starting from the offspring of the second
+  // generation.
+  evo.after_generation([](const population<i_mep> &, const summary<i_mep> &s)
+                       {
+                         if (s.gen == 0)
+                           latency_evaluator::peak = 0;
+                       });
+
+  const auto ret(evo.run(1));
+  CHECK(evo.debug());
+
+  CHECK(ret.perf.requests >= prob.env.individuals * prob.env.generations);
+  return ret;
+}
+
 TEST_SUITE("EVOLUTION")
 {
 
@@ -45,4 +111,326 @@ TEST_CASE_FIXTURE(fixture2, "Creation")
     }
 }
 
+TEST_CASE_FIXTURE(fixture2, "Merged statistics")
+{
+  using namespace vita;
+
+  prob.env.individuals = 50;
+  prob.env.mep.code_length = 40;
+  prob.env.layers = 4;
+
+  population<i_mep> pop(prob);
+  test_evaluator<i_mep> eva(test_evaluator_type::distinct);
+
+  // Two partial analyzers (e.g. filled by two threads) and a reference one.
+  analyzer<i_mep> az, az1, az2;
+  unsigned n(0);
+  for (auto it(pop.begin()), end(pop.end()); it != end; ++it, ++n)
+  {
+    az.add(*it, eva(*it), it.layer());
+    (n % 2 ? az1 : az2).add(*it, eva(*it), it.layer());
+  }
+
+  az1.merge(az2);
+
+  CHECK(az1.debug());
+  CHECK(az1.functions(false) == az.functions(false));
+  CHECK(az1.functions(true) == az.functions(true));
+  CHECK(az1.terminals(false) == az.terminals(false));
+  CHECK(az1.terminals(true) == az.terminals(true));
+
+  CHECK(std::equal(az1.begin(), az1.end(), az.begin(), az.end(),
+                   [](const auto &a, const auto &b)
+                   {
+                     return a.first == b.first
+                            && a.second.counter[0] == b.second.counter[0]
+                            && a.second.counter[1] == b.second.counter[1];
+                   }));
+
+  CHECK(az1.age_dist().count() == az.age_dist().count());
+  CHECK(az1.length_dist().mean() == doctest::Approx(az.length_dist().mean()));
+  CHECK(az1.fit_dist().mean()[0]
+        == doctest::Approx(az.fit_dist().mean()[0]));
+  CHECK(az1.fit_dist().seen() == az.fit_dist().seen());
+
+  for (unsigned l(0); l < pop.layers(); ++l)
+  {
+    CHECK(az1.fit_dist(l).count() == az.fit_dist(l).count());
+    CHECK(az1.fit_dist(l).mean()[0]
+          == doctest::Approx(az.fit_dist(l).mean()[0]));
+  }
+}
+
+TEST_CASE_FIXTURE(fixture2, "Incremental statistics")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lWARNING;
+
+  prob.env.individuals = 30;
+  prob.env.mep.code_length = 40;
+  prob.env.tournament_size = 3;
+  prob.env.generations = 20;
+
+  test_evaluator<i_mep> eva(test_evaluator_type::distinct);
+
+  // Statistics built from scratch for the population at the end of the
+  // previous generation (i.e. at the beginning of the current one).
+  analyzer<i_mep> expected;
+  unsigned checks(0);
+
+  const auto check([&](const population<i_mep> &pop, const summary<i_mep> &s)
+  {
+    if (s.gen)
+    {
+      const auto &az(s.az);
+
+      CHECK(az.functions(false) == expected.functions(false));
+      CHECK(az.functions(true) == expected.functions(true));
+      CHECK(az.terminals(false) == expected.terminals(false));
+      CHECK(az.terminals(true) == expected.terminals(true));
+
+      CHECK(std::equal(az.begin(), az.end(),
+                       expected.begin(), expected.end(),
+                       [](const auto &a, const auto &b)
+                       {
+                         return a.first == b.first
+                                && a.second.counter[0] == b.second.counter[0]
+                                && a.second.counter[1] == b.second.counter[1];
+                       }));
+
+      CHECK(az.age_dist().mean()
+            == doctest::Approx(expected.age_dist().mean()));
+      CHECK(az.length_dist().mean()
+            == doctest::Approx(expected.length_dist().mean()));
+      CHECK(az.fit_dist().mean()[0]
+            == doctest::Approx(expected.fit_dist().mean()[0]));
+      CHECK(az.fit_dist().seen() == expected.fit_dist().seen());
+
+      ++checks;
+    }
+
+    expected.clear();
+    for (auto it(pop.begin()), end(pop.end()); it != end; ++it)
+      expected.add(*it, eva(*it), it.layer());
+  });
+
+  SUBCASE("Standard evolution")
+  {
+    evolution<i_mep, std_es> evo(prob, eva);
+    evo.after_generation(check).run(1);
+  }
+
+  SUBCASE("ALPS")
+  {
+    evolution<i_mep, alps_es> evo(prob, eva);
+    evo.after_generation(check).run(1);
+  }
+
+  CHECK(checks == prob.env.generations);
+}
+
+TEST_CASE_FIXTURE(fixture2, "Replacement observer")
+{
+  using namespace vita;
+  using coord = population<i_mep>::coord;
+
+  prob.env.individuals = 10;
+  prob.env.elitism = trilean::no;  // the offspring always replaces
+
+  population<i_mep> pop(prob);
+  test_evaluator<i_mep> eva(test_evaluator_type::distinct);
+  summary<i_mep> s;
+
+  const i_mep off(prob);
+  const coord target{0, 4};
+  const auto old(pop[target]);
+
+  std::vector<coord> seen;
+  const auto observer([&](const coord &c)
+                      {
+                        seen.push_back(c);
+                        if (c.index < pop.individuals(c.layer))
+                          CHECK(pop[c] == old);  // still in place
+                      });
+
+  // Written slots are reported before the change.
+  replacement::tournament<i_mep> rep(pop, eva);
+  rep.observe(observer);
+  rep.run({{0, 1}, target}, {off}, &s);
+  CHECK(seen == std::vector<coord>{target});
+  CHECK(pop[target] == off);
+
+  // Appended individuals too.
+  pop.pop_from_layer(0);
+  seen.clear();
+
+  replacement::alps<i_mep> rep_alps(pop, eva);
+  rep_alps.observe(observer);
+  rep_alps.run({{0, 1}, {0, 2}}, {off}, &s);
+  CHECK(seen == std::vector<coord>{{0, pop.individuals(0) - 1}});
+  CHECK(pop[seen.back()] == off);
+}
+
+TEST_CASE_FIXTURE(fixture2, "Performance counters")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lWARNING;
+
+  prob.env.individuals = 30;
+  prob.env.mep.code_length = 40;
+  prob.env.tournament_size = 3;
+  prob.env.generations = 10;
+
+  evaluator_proxy<i_mep, test_evaluator<i_mep>> eva(
+    test_evaluator<i_mep>(test_evaluator_type::distinct), 10);
+
+  perf_counters last;
+  unsigned calls(0);
+
+  const auto check([&](const population<i_mep> &, const summary<i_mep> &s)
+  {
+    const auto &p(s.perf);
+
+    CHECK(p.requests > last.requests);
+    CHECK(p.evaluations > last.evaluations);
+    CHECK(p.cache_probes >= last.cache_probes);
+    CHECK(p.cache_hits <= p.cache_probes);
+    CHECK(p.selection >= last.selection);
+    CHECK(p.recombination >= last.recombination);
+    CHECK(p.replacement >= last.replacement);
+    CHECK(p.statistics >= last.statistics);
+    CHECK(p.evaluation >= last.evaluation);
+
+    // Every request goes through the cache and only the misses are
+    // evaluated.
+    CHECK(p.cache_probes == p.requests);
+    CHECK(p.evaluations <= p.requests - p.cache_hits);
+
+    last = p;
+    ++calls;
+  });
+
+  for (unsigned run(0); run < 2; ++run)
+  {
+    last = perf_counters();
+
+    evolution<i_mep, std_es> evo(prob, eva);
+    const auto s(evo.after_generation(check).run(run));
+
+    // Counters refer to the current run (the cache is shared).
+    CHECK(s.perf.requests == last.requests);
+    CHECK(s.perf.evaluations == last.evaluations);
+    CHECK(s.perf.cache_hits > 0);
+    CHECK(s.perf.selection.count() > 0);
+    CHECK(s.evaluations_per_second() >= 0.0);
+  }
+
+  CHECK(calls == 2 * (prob.env.generations + 1));
+}
+
+TEST_CASE_FIXTURE(fixture2, "Log files")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lWARNING;
+
+  prob.env.individuals = 30;
+  prob.env.mep.code_length = 40;
+  prob.env.tournament_size = 3;
+  prob.env.generations = 10;
+
+  const auto dir(std::filesystem::temp_directory_path() / "vita_log_test");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  prob.env.stat.dir = dir.string();
+  prob.env.stat.dynamic_file = "dynamic.txt";
+  prob.env.stat.layers_file = "layers.txt";
+
+  const auto read([&](const std::string &f)
+  {
+    std::ifstream in(dir / f, std::ios_base::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+
+    // Leading separator depends on the runs logged before.
+    auto ret(ss.str());
+    ret.erase(0, ret.find_first_not_of('\n'));
+    return ret;
+  });
+
+  // Same evolution logged twice: in text and binary format.
+  for (bool binary : {false, true})
+  {
+    prob.env.stat.binary_population = binary;
+    prob.env.stat.population_file = binary ? "population.bin"
+                                           : "population.txt";
+
+    random::seed(42);
+    test_evaluator<i_mep> eva(test_evaluator_type::distinct);
+    evolution<i_mep, alps_es> evo(prob, eva);
+    evo.run(2);
+  }
+
+  // Files are complete when `run` returns (one line per generation, the
+  // initial population included).
+  const auto dyn(read("dynamic.txt"));
+  CHECK(std::count(dyn.begin(), dyn.end(), '\n')
+        == 2 * (prob.env.generations + 1));
+  CHECK(!read("layers.txt").empty());
+
+  const auto text(read("population.txt"));
+  CHECK(!text.empty());
+
+  std::ifstream bin(dir / "population.bin", std::ios_base::binary);
+  std::stringstream converted;
+  CHECK(population_log::binary_to_text(bin, converted));
+
+  auto conv(converted.str());
+  conv.erase(0, conv.find_first_not_of('\n'));
+  CHECK(conv == text);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_CASE_FIXTURE(fixture2, "Evaluations in flight")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lWARNING;
+
+  prob.env.individuals = 30;
+  prob.env.mep.code_length = 40;
+  prob.env.generations = 6;
+
+  const std::vector<latency_evaluator> fast_first{
+    latency_evaluator(100), latency_evaluator(400), latency_evaluator(700),
+    latency_evaluator(1000)};
+  const std::vector<latency_evaluator> slow_first(fast_first.rbegin(),
+                                                  fast_first.rend());
+
+  // Evaluators differ only in their latency: the completion order of the
+  // evaluations changes between the two pools.
+  const auto check([&](auto run)
+  {
+    run(prob, 1, fast_first);
+    CHECK(latency_evaluator::peak == 1);
+
+    // Results are integrated in submission order: the evolution is
+    // reproducible...
+    const auto s1(run(prob, 4, fast_first));
+    CHECK(latency_evaluator::peak > 1);  // ... while evaluations overlap
+    const auto s2(run(prob, 4, slow_first));
+    CHECK(latency_evaluator::peak > 1);
+
+    CHECK(s1.best.solution == s2.best.solution);
+    CHECK(s1.best.score.fitness == s2.best.score.fitness);
+  });
+
+  SUBCASE("Standard evolution strategy") { check(in_flight_run<std_es>); }
+  SUBCASE("ALPS") { check(in_flight_run<alps_es>); }
+}
+
 }  // TEST_SUITE("EVOLUTION")
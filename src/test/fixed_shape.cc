@@ -0,0 +1,157 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstdlib>
+#include <set>
+#include <sstream>
+
+#include "kernel/i_mep.h"
+#include "kernel/problem.h"
+#include "kernel/src/primitive/factory.h"
+#include "kernel/src/primitive/real.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+// This test is linked to a framework built with a compile-time genome shape
+// (see `test/CMakeLists.txt`).
+static_assert(VITA_MEP_CODE_LENGTH == 100);
+static_assert(VITA_MEP_CATEGORIES == 1);
+static_assert(vita::gene::k_args == 4);
+
+namespace
+{
+
+struct fixed_shape_fixture
+{
+  fixed_shape_fixture()
+  {
+    prob.env.init().mep.code_length = VITA_MEP_CODE_LENGTH;
+
+    for (const auto *s : {"1.0", "2.0", "3.0", "FADD", "FSUB", "FMUL",
+                          "FIFL"})
+      prob.sset.insert(factory.make(s));
+  }
+
+  // Active loci computed following the arguments (reference for the
+  // iterator).
+  static std::set<vita::locus> active(const vita::i_mep &i)
+  {
+    std::set<vita::locus> ret;
+
+    const auto visit([&](vita::locus l, const auto &self) -> void
+    {
+      if (!ret.insert(l).second)
+        return;
+
+      for (unsigned j(0); j < i[l].sym->arity(); ++j)
+        self(i[l].arg_locus(j), self);
+    });
+
+    visit(i.best(), visit);
+    return ret;
+  }
+
+  vita::problem prob;
+  vita::symbol_factory factory;
+};
+
+}  // namespace
+
+TEST_SUITE("FIXED_SHAPE")
+{
+
+TEST_CASE_FIXTURE(fixed_shape_fixture, "Shape")
+{
+  for (unsigned n(0); n < 100; ++n)
+  {
+    const vita::i_mep i(prob);
+
+    CHECK(i.debug());
+    CHECK(i.size() == VITA_MEP_CODE_LENGTH);
+    CHECK(i.categories() == VITA_MEP_CATEGORIES);
+
+    const auto expected(active(i));
+    const std::set<vita::locus> found(
+      [&i]
+      {
+        std::set<vita::locus> ret;
+        for (auto it(i.begin()); it != i.end(); ++it)
+          ret.insert(it.locus());
+        return ret;
+      }());
+
+    CHECK(found == expected);
+    CHECK(i.active_symbols() == expected.size());
+  }
+
+  const vita::i_mep empty;
+  CHECK(empty.empty());
+  CHECK(empty.begin() == empty.end());
+}
+
+TEST_CASE_FIXTURE(fixed_shape_fixture, "Wrong shape")
+{
+  prob.env.mep.code_length = VITA_MEP_CODE_LENGTH / 2;
+  CHECK_THROWS_AS(vita::i_mep{prob}, std::invalid_argument);
+
+  prob.env.mep.code_length = VITA_MEP_CODE_LENGTH;
+  prob.sset.insert(factory.make("REAL", {1}));
+  CHECK_THROWS_AS(vita::i_mep{prob}, std::invalid_argument);
+
+  // Symbols wider than the gene are rejected.
+  CHECK_THROWS_AS(prob.sset.insert<vita::real::ifb>(), std::invalid_argument);
+}
+
+TEST_CASE_FIXTURE(fixed_shape_fixture, "Crossover and mutation")
+{
+  for (unsigned n(0); n < 1000; ++n)
+  {
+    const vita::i_mep i1(prob), i2(prob);
+
+    auto off(crossover(i1, i2));
+    CHECK(off.debug());
+
+    for (vita::index_t j(0); j < off.size(); ++j)
+    {
+      const vita::locus l{j, 0};
+      CHECK((off[l] == i1[l] || off[l] == i2[l]));
+    }
+
+    off.mutation(0.1, prob);
+    CHECK(off.debug());
+    CHECK(off.signature() == vita::i_mep(off).signature());
+  }
+}
+
+TEST_CASE_FIXTURE(fixed_shape_fixture, "Serialization")
+{
+  for (unsigned n(0); n < 100; ++n)
+  {
+    std::stringstream ss;
+    const vita::i_mep i1(prob);
+    CHECK(i1.save(ss));
+
+    vita::i_mep i2;
+    CHECK(i2.load(ss, prob.sset));
+    CHECK(i2.debug());
+    CHECK(i1 == i2);
+  }
+
+  // A genome with a different shape cannot be loaded.
+  std::stringstream ss;
+  ss << "0\n" << VITA_MEP_CODE_LENGTH / 2 << " 1\n";
+  vita::i_mep i;
+  CHECK(!i.load(ss, prob.sset));
+}
+
+}  // TEST_SUITE("FIXED_SHAPE")
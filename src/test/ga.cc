@@ -29,6 +29,10 @@ TEST_SUITE("GA")
 
 TEST_CASE_FIXTURE(fixture6, "Evolution")
 {
+  // The thresholds are reached by most (not all) runs: the seed makes the
+  // test independent from the tests executed before.
+  vita::random::seed(42);
+
   prob.env.individuals = 100;
 
   vita::log::reporting_level = vita::log::lWARNING;
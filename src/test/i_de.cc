@@ -84,6 +84,21 @@ TEST_CASE_FIXTURE(fixture5, "Iterators")
   }
 }
 
+TEST_CASE_FIXTURE(fixture5, "Genome view")
+{
+  for (unsigned j(0); j < 1000; ++j)
+  {
+    const vita::i_de ind(prob);
+
+    const vita::span<const double> view(ind);
+    CHECK(view.size() == ind.parameters());
+    CHECK(view.data() == &*ind.begin());
+
+    const std::vector<double> copy(ind);
+    CHECK(std::equal(view.begin(), view.end(), copy.begin(), copy.end()));
+  }
+}
+
 TEST_CASE_FIXTURE(fixture5, "DE crossover")
 {
   double diff(0), length(0);
@@ -117,6 +117,21 @@ TEST_CASE_FIXTURE(fixture6, "Iterators")
   }
 }
 
+TEST_CASE_FIXTURE(fixture6, "Genome view")
+{
+  for (unsigned j(0); j < 1000; ++j)
+  {
+    const vita::i_ga ind(prob);
+
+    const vita::span<const int> view(ind);
+    CHECK(view.size() == ind.parameters());
+    CHECK(view.data() == &*ind.begin());
+
+    const std::vector<int> copy(ind);
+    CHECK(std::equal(view.begin(), view.end(), copy.begin(), copy.end()));
+  }
+}
+
 TEST_CASE_FIXTURE(fixture6, "Standard crossover")
 {
   vita::i_ga i1(prob), i2(prob);
@@ -15,6 +15,7 @@
 
 #include "kernel/i_mep.h"
 #include "kernel/interpreter.h"
+#include "kernel/src/primitive/real.h"
 
 #include "fixture1.h"
 #include "fixture3.h"
@@ -39,6 +40,72 @@ TEST_CASE_FIXTURE(fixture3, "Random creation")
   }
 }
 
+TEST_CASE_FIXTURE(fixture3, "Compact genes")
+{
+  static_assert(std::is_trivially_copyable_v<vita::gene>);
+  CHECK(sizeof(vita::basic_gene<4>) <= sizeof(void *) + sizeof(double));
+
+  for (unsigned n(0); n < 1000; ++n)
+  {
+    const vita::i_mep i(prob);
+    const vita::i_mep copy(i);
+
+    CHECK(copy == i);
+    CHECK(copy.signature() == i.signature());
+
+    for (vita::index_t j(0); j < i.size(); ++j)
+      for (vita::category_t c(0); c < i.categories(); ++c)
+        CHECK(i[{j, c}] == copy[{j, c}]);
+  }
+}
+
+TEST_CASE_FIXTURE(fixture3, "Wide functions")
+{
+  using namespace vita;
+
+  // Five arguments function.
+  auto *f_ifb(prob.sset.insert<real::ifb>());
+  REQUIRE(f_ifb->arity() == 5);
+
+  const i_mep i({
+                  {{f_ifb, {1, 2, 3, 4, 5}}},  // [0] FIFB 1,2,3,4,5
+                  {{   c1,            null}},  // [1] 1.0
+                  {{   c0,            null}},  // [2] 0.0
+                  {{   c2,            null}},  // [3] 2.0
+                  {{   c3,            null}},  // [4] 3.0
+                  {{    y,            null}}   // [5] 321.0
+                });
+  CHECK(i.debug());
+
+  for (unsigned j(0); j < 5; ++j)
+    CHECK(i[{0, 0}].arg_locus(j).index == j + 1);
+
+  CHECK(std::get<D_DOUBLE>(interpreter<i_mep>(&i).run())
+        == doctest::Approx(3.0));
+
+  std::stringstream ss;
+  REQUIRE(i.save(ss));
+  i_mep i1;
+  REQUIRE(i1.load(ss, prob.sset));
+  CHECK(i1 == i);
+
+  for (unsigned n(0); n < 100; ++n)
+  {
+    const i_mep r(prob);
+    CHECK(r.debug());
+  }
+
+  // Functions wider than a gene are rejected.
+  class wide : public function
+  {
+  public:
+    wide() : function("WIDE", 0, cvect(gene::k_args + 1, 0)) {}
+    value_t eval(core_interpreter *) const override { return {}; }
+  };
+
+  CHECK_THROWS_AS(prob.sset.insert<wide>(), std::invalid_argument);
+}
+
 TEST_CASE_FIXTURE(fixture3, "Empty individual")
 {
   vita::i_mep i;
@@ -137,6 +204,84 @@ TEST_CASE_FIXTURE(fixture3, "Crossover")
   }
 }
 
+TEST_CASE_FIXTURE(fixture3, "Active genes")
+{
+  using namespace vita;
+
+  for (unsigned l(prob.sset.categories() + 2); l < 100; ++l)
+  {
+    prob.env.mep.code_length = l;
+    const i_mep ind(prob);
+
+    // Reference traversal based on an explicit ordered worklist.
+    std::vector<locus> expected;
+    std::set<locus> todo({ind.best()});
+    while (!todo.empty())
+    {
+      const locus cur(*todo.begin());
+      todo.erase(todo.begin());
+      expected.push_back(cur);
+
+      const gene &g(ind[cur]);
+      for (unsigned j(0); j < g.sym->arity(); ++j)
+        todo.insert(g.arg_locus(j));
+    }
+
+    std::vector<locus> active;
+    for (auto i(ind.begin()); i != ind.end(); ++i)
+    {
+      CHECK(&*i == &ind[i.locus()]);
+      active.push_back(i.locus());
+    }
+
+    CHECK(active == expected);
+    CHECK(ind.active_symbols() == expected.size());
+  }
+
+  CHECK(i_mep().begin() == i_mep().end());
+}
+
+TEST_CASE_FIXTURE(fixture3, "Shared genome")
+{
+  using namespace vita;
+
+  prob.env.mep.code_length = 100;
+
+  const auto dump([](const i_mep &i)
+  {
+    std::stringstream ss;
+    i.save(ss);
+    return ss.str();
+  });
+
+  for (unsigned j(0); j < 1000; ++j)
+  {
+    const i_mep p1(prob), p2(prob);
+    const auto s1(dump(p1)), s2(dump(p2));
+
+    // Offspring share genome blocks with their parents: changing them mustn't
+    // affect the parents.
+    i_mep o1(crossover(p1, p2));
+    o1.mutation(0.5, prob);
+    CHECK(o1.debug());
+
+    i_mep o2(o1);
+    const auto so1(dump(o1));
+    o2.mutation(0.5, prob);
+    CHECK(o2.debug());
+
+    CHECK(dump(p1) == s1);
+    CHECK(dump(p2) == s2);
+    CHECK(dump(o1) == so1);
+
+    // Zero probability mutation doesn't change anything.
+    i_mep o3(crossover(p1, p2));
+    const i_mep orig(o3);
+    o3.mutation(0.0, prob);
+    CHECK(o3 == orig);
+  }
+}
+
 TEST_CASE_FIXTURE(fixture3, "Serialization")
 {
   // Non-empty i_mep serialization.
@@ -168,6 +313,30 @@ TEST_CASE_FIXTURE(fixture3, "Serialization")
   CHECK(empty1.empty());
 
   CHECK(empty == empty1);
+
+  // Files written before the crossover type was saved are still readable.
+  std::stringstream old_format;
+  const vita::i_mep o1(prob), o2(prob);
+  for (const auto &o : {o1, o2})
+  {
+    std::stringstream tmp;
+    CHECK(o.save(tmp));
+
+    std::string age, header;
+    std::getline(tmp, age);
+    std::getline(tmp, header);
+    header.erase(header.rfind(' '));
+
+    old_format << age << '\n' << header << '\n' << tmp.rdbuf();
+  }
+
+  vita::i_mep l1, l2;
+  CHECK(l1.load(old_format, prob.sset));
+  CHECK(l2.load(old_format, prob.sset));
+  CHECK(l1.debug());
+  CHECK(l2.debug());
+  CHECK(l1 == o1);
+  CHECK(l2 == o2);
 }
 
 TEST_CASE_FIXTURE(fixture3, "Blocks")
@@ -14,6 +14,7 @@
 #include <sstream>
 
 #include "kernel/random.h"
+#include "utility/cow_matrix.h"
 #include "utility/matrix.h"
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
@@ -195,6 +196,97 @@ TEST_CASE("Rotation")
   CHECK(r270 == vita::rot90(   m, 3));
 }
 
+TEST_CASE("Copy-on-write")
+{
+  using namespace vita;
+
+  const std::size_t rows(5 * cow_matrix<int>::chunk_rows + 3), cols(2);
+
+  cow_matrix<int> m(rows, cols);
+  CHECK(m.rows() == rows);
+  CHECK(m.cols() == cols);
+  CHECK(!m.empty());
+  CHECK(cow_matrix<int>().empty());
+
+  for (std::size_t r(0); r < rows; ++r)
+    for (std::size_t c(0); c < cols; ++c)
+      m(r, c) = random::between(0, 1000);
+
+  // Read only access goes through a const reference (non-const accessors
+  // detach the chunk).
+  const cow_matrix<int> &cm(m);
+
+  // Copies share every chunk.
+  auto m1(m);
+  CHECK(m1 == m);
+  CHECK(m1.shared_chunks(cm) == 6);
+
+  // Writing detaches just one chunk.
+  m1(0, 0) = cm(0, 0) + 1;
+  CHECK(m1 != m);
+  CHECK(m1.shared_chunks(cm) == 5);
+  CHECK(cm(0, 0) + 1 == m1(0, 0));
+
+  // Setting the same value doesn't detach.
+  m1.set({static_cast<index_t>(rows - 1), 1}, cm(rows - 1, 1));
+  CHECK(m1.shared_chunks(cm) == 5);
+
+  // Whole chunks are shared, partial chunks are copied.
+  cow_matrix<int> m2(rows, cols);
+  m2.assign_rows(cm, 3, rows);
+  CHECK(m2.shared_chunks(cm) == 5);
+
+  for (std::size_t r(0); r < rows; ++r)
+    for (std::size_t c(0); c < cols; ++c)
+      CHECK(std::as_const(m2)(r, c) == (r < 3 ? 0 : cm(r, c)));
+
+  m2.assign_rows(cm, 0, 3);
+  CHECK(m2 == m);
+}
+
+TEST_CASE("Copy-on-write fixed shape")
+{
+  using namespace vita;
+
+  constexpr std::size_t rows(2 * cow_matrix<int>::chunk_rows + 5), cols(3);
+  using fixed_matrix = cow_matrix<int, rows, cols>;
+
+  CHECK(fixed_matrix().empty());
+  CHECK(fixed_matrix().cols() == 0);
+  CHECK(fixed_matrix() == fixed_matrix());
+
+  fixed_matrix m(rows, cols);
+  CHECK(m.rows() == rows);
+  CHECK(m.cols() == cols);
+  CHECK(m != fixed_matrix());
+
+  cow_matrix<int> reference(rows, cols);
+
+  for (std::size_t r(0); r < rows; ++r)
+    for (std::size_t c(0); c < cols; ++c)
+      m(r, c) = reference(r, c) = random::between(0, 1000);
+
+  const fixed_matrix &cm(m);
+
+  auto m1(m);
+  CHECK(m1 == m);
+  CHECK(m1.shared_chunks(cm) == 3);
+
+  // The last chunk is partially used.
+  m1(rows - 1, cols - 1) = cm(rows - 1, cols - 1) + 1;
+  CHECK(m1 != m);
+  CHECK(m1.shared_chunks(cm) == 2);
+
+  fixed_matrix m2(rows, cols);
+  m2.assign_rows(cm, 0, rows);
+  CHECK(m2 == m);
+  CHECK(m2.shared_chunks(cm) == 3);
+
+  for (std::size_t r(0); r < rows; ++r)
+    for (std::size_t c(0); c < cols; ++c)
+      CHECK(cm(r, c) == std::as_const(reference)(r, c));
+}
+
 TEST_CASE("Serialization")
 {
   vita::matrix<int> m(100, 100);
@@ -0,0 +1,218 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+
+#if !defined(WIN32) && !defined(_WIN32) && !defined(__WIN32)
+#  include <sys/socket.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#  define VITA_TEST_SOCKETS
+#endif
+
+#include "kernel/evolution.h"
+#include "kernel/i_mep.h"
+#include "kernel/migration.h"
+
+#include "test/fixture2.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+TEST_SUITE("MIGRATION")
+{
+
+TEST_CASE("Hub")
+{
+  using namespace vita;
+
+  const std::string address(
+    "unix:" + (std::filesystem::temp_directory_path()
+               / "vita_migration_hub").string());
+
+  migration_link missing;
+  CHECK(!missing.connect(address));
+  CHECK(!missing.connected());
+
+  migration_hub hub(address);
+  REQUIRE(hub.listening());
+  std::thread server([&hub] { hub.run(); });
+
+  migration_link l1, l2, l3;
+  REQUIRE(l1.connect(address));
+  REQUIRE(l2.connect(address));
+  REQUIRE(l3.connect(address));
+
+  std::vector<std::string> in;
+  CHECK(l1.exchange("alpha", &in));
+  CHECK(in.empty());
+
+  CHECK(l2.exchange("beta", &in));
+  CHECK(in == std::vector<std::string>{"alpha"});
+
+  // Every packet is delivered once...
+  CHECK(l1.exchange("", &in));
+  CHECK(in == std::vector<std::string>{"beta"});
+  CHECK(l1.exchange("", &in));
+  CHECK(in.empty());
+
+  // ... and only the last packet of an island is kept.
+  CHECK(l1.exchange("gamma", &in));
+  CHECK(l1.exchange("delta", &in));
+  CHECK(l3.exchange(std::string("binary\0data", 11), &in));
+  CHECK(in == std::vector<std::string>{"delta", "beta"});
+
+  // A disconnected island doesn't disturb the others.
+  l2.close();
+  CHECK(!l2.exchange("", &in));
+  CHECK(l1.exchange("", &in));
+  CHECK(in == std::vector<std::string>{std::string("binary\0data", 11)});
+
+  // Large packets are split among many replies.
+  const std::string big1(40 << 20, 'a'), big2(40 << 20, 'b');
+  CHECK(l1.exchange(big1, &in));
+  CHECK(l3.exchange(big2, &in));
+  CHECK(in == std::vector<std::string>{big1});
+
+  migration_link l4;
+  REQUIRE(l4.connect(address));
+  CHECK(l4.exchange("", &in));
+  CHECK(in.size() == 2);
+  CHECK(l4.exchange("", &in));
+  CHECK(in.size() == 1);
+  CHECK(l4.exchange("", &in));
+  CHECK(in.empty());
+
+  // Oversized packets close the connection.
+  CHECK(!l1.exchange(std::string(64 << 20, 'c'), &in));
+  CHECK(!l1.connected());
+
+  hub.stop();
+  server.join();
+}
+
+TEST_CASE_FIXTURE(fixture2, "Islands")
+{
+  using namespace vita;
+
+  const std::string address(
+    "unix:" + (std::filesystem::temp_directory_path()
+               / "vita_migration_islands").string());
+
+  migration_hub hub(address);
+  REQUIRE(hub.listening());
+  std::thread server([&hub] { hub.run(); });
+
+  prob.env.individuals = 30;
+  prob.env.mep.code_length = 40;
+  prob.env.generations = 4;
+  prob.env.migration.coordinator = address;
+  prob.env.migration.interval = 2;
+  prob.env.migration.migrants = 3;
+
+  // A second island sends an individual before the start of the evolution.
+  const i_mep migrant(prob);
+  std::ostringstream ss;
+  REQUIRE(migrant.save(ss));
+
+  migration_link other;
+  REQUIRE(other.connect(address));
+  std::vector<std::string> in;
+  REQUIRE(other.exchange(ss.str(), &in));
+
+  test_evaluator<i_mep> eva(test_evaluator_type::distinct);
+  evolution<i_mep, std_es> evo(prob, eva);
+
+  bool arrived(false);
+  evo.after_generation([&](const population<i_mep> &pop,
+                           const summary<i_mep> &s)
+                       {
+                         // Migration happens at the end of generation `1`.
+                         if (s.gen == 1)
+                           for (const auto &prg : pop)
+                             arrived = arrived || prg == migrant;
+                       });
+  evo.run(1);
+  CHECK(arrived);
+
+  // The other island receives the emigrants of the last exchange.
+  REQUIRE(other.exchange("", &in));
+  REQUIRE(in.size() == 1);
+
+  std::istringstream packet(in.front());
+  unsigned received(0);
+  for (i_mep prg; prg.load(packet, prob.sset);)
+  {
+    CHECK(prg.debug());
+    ++received;
+  }
+  CHECK(received == prob.env.migration.migrants);
+
+  hub.stop();
+  server.join();
+}
+
+#if defined(VITA_TEST_SOCKETS)
+TEST_CASE("Stalled island")
+{
+  using namespace vita;
+
+  const auto path((std::filesystem::temp_directory_path()
+                   / "vita_migration_stalled").string());
+
+  migration_hub hub("unix:" + path);
+  REQUIRE(hub.listening());
+  std::thread server([&hub] { hub.run(); });
+
+  migration_link l1, l2;
+  REQUIRE(l1.connect("unix:" + path));
+  REQUIRE(l2.connect("unix:" + path));
+
+  std::vector<std::string> in;
+  CHECK(l1.exchange(std::string(8 << 20, 'a'), &in));
+
+  // An island sending requests without reading the replies. The first
+  // reply (with the packet of `l1`) doesn't fit in the socket buffer.
+  sockaddr_un sa{};
+  sa.sun_family = AF_UNIX;
+  std::strcpy(sa.sun_path, path.c_str());
+
+  const int stalled(::socket(AF_UNIX, SOCK_STREAM, 0));
+  REQUIRE(stalled >= 0);
+  REQUIRE(::connect(stalled, reinterpret_cast<const sockaddr *>(&sa),
+                    sizeof(sa)) == 0);
+
+  const char empty_exchange[8] = {0, 0, 0, 1, 0, 0, 0, 0};
+  for (unsigned i(0); i < 3; ++i)
+    REQUIRE(::send(stalled, empty_exchange, sizeof(empty_exchange), 0)
+            == sizeof(empty_exchange));
+
+  // The other islands are still served.
+  for (unsigned i(0); i < 3; ++i)
+  {
+    CHECK(l2.exchange("beta", &in));
+    CHECK(l1.exchange("", &in));
+    CHECK(in == std::vector<std::string>{"beta"});
+  }
+
+  ::close(stalled);
+  CHECK(l2.exchange("", &in));
+
+  hub.stop();
+  server.join();
+}
+#endif
+
+}  // TEST_SUITE("MIGRATION")
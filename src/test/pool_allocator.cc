@@ -0,0 +1,144 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "utility/pool_allocator.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+TEST_SUITE("POOL_ALLOCATOR")
+{
+
+TEST_CASE("Recycling")
+{
+  vita::pool_allocator<double> a;
+
+  std::set<double *> blocks;
+  for (unsigned i(0); i < 100; ++i)
+    blocks.insert(a.allocate(10));
+  CHECK(blocks.size() == 100);
+
+  for (auto *p : blocks)
+    a.deallocate(p, 10);
+
+  // Blocks of the same size class are reused.
+  for (unsigned i(0); i < 100; ++i)
+  {
+    auto *p(a.allocate(9));
+    CHECK(blocks.count(p));
+    a.deallocate(p, 9);
+  }
+
+  // Large blocks bypass the pool.
+  auto *p(a.allocate(10000));
+  p[9999] = 1.0;
+  a.deallocate(p, 10000);
+}
+
+TEST_CASE("Bounded free lists")
+{
+  using namespace vita;
+
+  constexpr std::size_t bytes(1024);
+  constexpr auto limit(detail::block_pool::max_cached / bytes);
+
+  pool_allocator<char> a;
+
+  // Blocks allocated by another thread and released here.
+  std::vector<char *> blocks;
+  std::thread t([&]
+  {
+    for (std::size_t i(0); i < 4 * limit; ++i)
+      blocks.push_back(a.allocate(bytes));
+  });
+  t.join();
+
+  const auto before(detail::local_pool()->cached(bytes));
+  for (auto *p : blocks)
+    a.deallocate(p, bytes);
+
+  CHECK(detail::local_pool()->cached(bytes) == std::max(before, limit));
+}
+
+TEST_CASE("Allocation without pool")
+{
+  using namespace vita;
+
+  constexpr std::size_t bytes(17);
+  constexpr auto block(2 * detail::block_pool::granularity);
+
+  // A thread-local object destroyed after the pool of its thread.
+  struct late
+  {
+    ~late() { p = pool_allocator<char>().allocate(bytes); }
+
+    char *&p;
+  };
+
+  char *p(nullptr);
+  std::thread t([&]
+  {
+    thread_local late l{p};
+    (void)l;
+    detail::local_pool();  // constructed after `l`, destroyed before
+  });
+  t.join();
+  REQUIRE(p);
+
+  // The block reaches the free list of a live pool...
+  pool_allocator<char> a;
+  const auto before(detail::local_pool()->cached(bytes));
+  a.deallocate(p, bytes);
+  CHECK(detail::local_pool()->cached(bytes) == before + 1);
+
+  // ... and has the full size of its class.
+  auto *q(a.allocate(block));
+  CHECK(q == p);
+  std::fill(q, q + block, 'x');
+  CHECK(std::count(q, q + block, 'x') == block);
+  a.deallocate(q, block);
+}
+
+TEST_CASE("Containers")
+{
+  using namespace vita;
+
+  std::vector<int, pool_allocator<int>> v;
+  std::list<int, pool_allocator<int>> l;
+  for (int i(0); i < 1000; ++i)
+  {
+    v.push_back(i);
+    l.push_front(i);
+  }
+
+  for (int i(0); i < 1000; ++i)
+  {
+    CHECK(v[i] == i);
+    CHECK(l.back() == i);
+    l.pop_back();
+  }
+
+  const auto p(std::allocate_shared<std::vector<int, pool_allocator<int>>>(
+                 pool_allocator<int>(), v));
+  CHECK(*p == v);
+  CHECK(pool_allocator<int>() == pool_allocator<double>());
+}
+
+}  // TEST_SUITE("POOL_ALLOCATOR")
@@ -75,10 +75,20 @@ TEST_CASE_FIXTURE(fixture1, "Serialization")
   for (unsigned i(0); i < 100; ++i)
   {
     prob.env.individuals = random::between(30, 300);
+    prob.env.layers = random::between(1, 8);
 
     std::stringstream ss;
     population<i_mep> pop1(prob);
 
+    // Layers with different sizes and ages.
+    for (unsigned l(0); l < pop1.layers(); ++l)
+    {
+      const auto n(random::between(0u, pop1.individuals(l) / 2));
+      for (unsigned j(0); j < n; ++j)
+        pop1.pop_from_layer(l);
+    }
+    pop1.inc_age();
+
     CHECK(pop1.save(ss));
 
     decltype(pop1) pop2(prob);
@@ -90,11 +100,13 @@ TEST_CASE_FIXTURE(fixture1, "Serialization")
     for (unsigned l(0); l < pop1.layers(); ++l)
     {
       CHECK(pop1.individuals(l) == pop2.individuals(l));
+      CHECK(pop1.allowed(l) == pop2.allowed(l));
 
-      for (unsigned j(0); j < pop1.individuals(); ++j)
+      for (unsigned j(0); j < pop1.individuals(l); ++j)
       {
         const population<i_mep>::coord c{l, j};
         CHECK(pop1[c] == pop2[c]);
+        CHECK(pop1[c].age() == pop2[c].age());
       }
     }
   }
@@ -0,0 +1,180 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+
+#include "kernel/random.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+TEST_SUITE("RANDOM")
+{
+
+TEST_CASE("Jump")
+{
+  vigna::xoshiro256ss e1(1234), e2(1234);
+  e1.jump();
+  CHECK(e1 != e2);
+  e2.jump();
+  CHECK(e1 == e2);
+
+  e1.long_jump();
+  CHECK(e1 != e2);
+  e2.long_jump();
+  CHECK(e1 == e2);
+
+  vigna::xoroshiro128p f1(1234), f2(1234);
+  f1.jump();
+  CHECK(f1 != f2);
+  f2.jump();
+  CHECK(f1 == f2);
+
+  f1.long_jump();
+  CHECK(f1 != f2);
+  f2.long_jump();
+  CHECK(f1 == f2);
+}
+
+TEST_CASE("Streams")
+{
+  using namespace vita;
+
+  const unsigned master(20200101);
+
+  // The first substream is the plain seeded sequence.
+  random::seed(master);
+  const auto e(random::engine);
+  random::seed(master, 0);
+  CHECK(random::engine == e);
+
+  // Distinct substreams.
+  std::set<random::engine_t::result_type> first;
+  for (unsigned id(0); id < 32; ++id)
+  {
+    auto s(random::stream(master, id));
+    CHECK(first.insert(s()).second);
+  }
+
+  // Every worker gets its own, reproducible, substream.
+  const auto sequence([&](unsigned id)
+  {
+    random::seed(master, id);
+
+    std::vector<random::engine_t::result_type> ret;
+    for (unsigned i(0); i < 100; ++i)
+      ret.push_back(random::engine());
+
+    return ret;
+  });
+
+  for (unsigned id(0); id < 4; ++id)
+  {
+    const auto s1(sequence(id)), s2(sequence(id));
+    CHECK(s1 == s2);
+    CHECK(s1 != sequence(id + 1));
+  }
+}
+
+TEST_CASE("Between")
+{
+  using namespace vita;
+
+  const int min(-5), sup(12);
+  std::vector<unsigned> count(sup - min);
+
+  const unsigned n(1700000);
+  int low(sup), high(min);
+  for (unsigned i(0); i < n; ++i)
+  {
+    const auto r(random::between(min, sup));
+    low = std::min(low, r);
+    high = std::max(high, r);
+    ++count[r - min];
+  }
+
+  CHECK(low == min);
+  CHECK(high == sup - 1);
+
+  const double expected(n / count.size());
+  for (const auto c : count)
+    CHECK(c == doctest::Approx(expected).epsilon(0.02));
+
+  for (unsigned i(0); i < 1000; ++i)
+  {
+    const auto r(random::between<std::uint64_t>(1, 1ull << 40));
+    CHECK(1 <= r);
+    CHECK(r < 1ull << 40);
+  }
+}
+
+TEST_CASE("Boolean")
+{
+  using namespace vita;
+
+  for (unsigned i(0); i < 1000; ++i)
+  {
+    CHECK(!random::boolean(0.0));
+    CHECK(random::boolean(1.0));
+  }
+
+  for (const double p : {0.1, 0.3, 0.5, 0.9})
+  {
+    const unsigned n(1000000);
+    unsigned t(0);
+    for (unsigned i(0); i < n; ++i)
+      if (random::boolean(p))
+        ++t;
+
+    CHECK(static_cast<double>(t) / n == doctest::Approx(p).epsilon(0.02));
+  }
+}
+
+TEST_CASE("Fill")
+{
+  using namespace vita;
+
+  random::engine_t e1(42), e2(42);
+
+  std::vector<random::engine_t::result_type> v(100);
+  e1.fill(v.begin(), v.end());
+
+  for (const auto x : v)
+    CHECK(x == e2());
+  CHECK(e1 == e2);
+
+  std::vector<int> r(1000);
+  random::fill(r.begin(), r.end(), 3, 7);
+  CHECK(std::all_of(r.begin(), r.end(),
+                    [](int x) { return 3 <= x && x < 7; }));
+
+  // Odd length, negative values, uniformity.
+  const int min(-5), sup(2);
+  std::vector<int> b(100001, sup);
+  random::fill(b.begin(), b.end(), min, sup);
+
+  std::vector<unsigned> count(sup - min);
+  for (const auto x : b)
+  {
+    REQUIRE(min <= x);
+    REQUIRE(x < sup);
+    ++count[x - min];
+  }
+
+  const double expected(static_cast<double>(b.size()) / count.size());
+  for (const auto c : count)
+    CHECK(c == doctest::Approx(expected).epsilon(0.05));
+}
+
+}  // TEST_SUITE("RANDOM")
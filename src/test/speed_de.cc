@@ -46,23 +46,23 @@ TEST_CASE_FIXTURE(fixture5_no_init, "Test Problem 7")
   prob.sset.insert<ga::real>(vita::range(-3.2, 3.2));
   prob.sset.insert<ga::real>(vita::range(-3.2, 3.2));
 
-  auto f = [](const std::vector<double> &x)
+  auto f = [](vita::span<const double> x)
   {
     return -std::exp(x[0] * x[1] * x[2] * x[3] * x[4]);
   };
 
   auto p = [](const i_de &prg)
   {
-    auto h1 = [](const std::vector<double> &x)
+    auto h1 = [](vita::span<const double> x)
     {
       return x[0] * x[0] + x[1] * x[1] + x[2] * x[2] + x[3] * x[3] +
       x[4] * x[4] - 10.0;
     };
-    auto h2 = [](const std::vector<double> &x)
+    auto h2 = [](vita::span<const double> x)
     {
       return x[1] * x[2] - 5.0 * x[3] * x[4];
     };
-    auto h3 = [](const std::vector<double> &x)
+    auto h3 = [](vita::span<const double> x)
     {
       return x[0] * x[0] * x[0] + x[1] * x[1] * x[1] + 1.0;
     };
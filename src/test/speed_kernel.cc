@@ -0,0 +1,250 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "kernel/cache.h"
+#include "kernel/i_mep.h"
+#include "kernel/src/evaluator.h"
+#include "kernel/src/interpreter.h"
+#include "kernel/src/problem.h"
+#include "utility/csv_parser.h"
+
+#include "test/benchmark.h"
+
+namespace
+{
+
+void setup(vita::src_problem &pr, const std::string &csv)
+{
+  pr.env.init();
+
+  std::istringstream ss(csv);
+  pr.data().read_csv(ss);
+  pr.setup_symbols();
+}
+
+// Measures the evaluation of a population of `n` random programs.
+template<class E>
+void bench_evaluator(benchmark &b, const std::string &name,
+                     vita::src_problem &pr, unsigned n)
+{
+  std::vector<vita::i_mep> pool;
+  for (unsigned i(0); i < n; ++i)
+    pool.emplace_back(pr);
+
+  E eva(pr.data());
+  b.run("evaluator/" + name, n, [&](unsigned i) { return eva(pool[i]); });
+}
+
+void usage()
+{
+  std::cout <<
+    "Microbenchmarks for the hot paths of the kernel.\n\n"
+    "Usage:\n"
+    "  speed_kernel [options] [FILTER]\n\n"
+    "Options:\n"
+    "  --json FILE        writes the results in JSON format\n"
+    "  --baseline FILE    compares the results against a previous JSON\n"
+    "  --tolerance T      accepted relative slowdown [default: 0.10]\n"
+    "  --repetitions N    measured repetitions [default: 15]\n"
+    "  --warm-up N        unmeasured repetitions [default: 3]\n\n"
+    "Only the benchmarks whose name contains FILTER are run. The exit code\n"
+    "is the number of regressions found.\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  using namespace vita;
+
+  std::string json, baseline, filter;
+  double tolerance(0.10);
+  unsigned repetitions(15), warm_up(3);
+
+  for (int i(1); i < argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    const bool has_value(i + 1 < argc);
+
+    if (arg == "--json" && has_value)
+      json = argv[++i];
+    else if (arg == "--baseline" && has_value)
+      baseline = argv[++i];
+    else if (arg == "--tolerance" && has_value)
+      tolerance = std::stod(argv[++i]);
+    else if (arg == "--repetitions" && has_value)
+      repetitions = static_cast<unsigned>(std::stoul(argv[++i]));
+    else if (arg == "--warm-up" && has_value)
+      warm_up = static_cast<unsigned>(std::stoul(argv[++i]));
+    else if (arg.front() != '-' && filter.empty())
+      filter = arg;
+    else
+    {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  log::reporting_level = log::lWARNING;
+  random::seed(20200101);
+
+  benchmark b(repetitions, warm_up, filter);
+
+  const std::string reg_csv(synthetic_csv(1000, 4, false));
+  const std::string cla_csv(synthetic_csv(1000, 4, true));
+
+  src_problem reg, cla;
+  setup(reg, reg_csv);
+  setup(cla, cla_csv);
+
+  // -------------------------------------------------------------------------
+  // Data loading.
+  // -------------------------------------------------------------------------
+  b.run("csv_parser/1000_rows", 1, [&](unsigned)
+        {
+          std::istringstream ss(reg_csv);
+
+          std::size_t fields(0);
+          for (const auto &record : csv_parser(ss))
+            fields += record.size();
+
+          return fields;
+        });
+
+  b.run("dataframe/read_csv_1000_rows", 1, [&](unsigned)
+        {
+          std::istringstream ss(cla_csv);
+          return dataframe(ss).size();
+        });
+
+  // -------------------------------------------------------------------------
+  // Genetic operators.
+  // -------------------------------------------------------------------------
+  b.run("symbol_set/roulette", 100000,
+        [&](unsigned) { return &reg.sset.roulette(0); });
+
+  std::vector<i_mep> pool;
+  for (unsigned i(0); i < 1000; ++i)
+    pool.emplace_back(reg);
+
+  b.run("i_mep/crossover", 1000, [&](unsigned i)
+        {
+          return crossover(pool[i], pool[(i + 1) % pool.size()]);
+        });
+
+  std::vector<i_mep> offspring;
+  b.run("i_mep/mutation", 1000, [&](unsigned i)
+        {
+          return offspring[i].mutation(reg.env.p_mutation, reg);
+        },
+        [&] { offspring = pool; });
+
+  // Offspring have no cached signature: it's calculated at the first
+  // request.
+  b.run("i_mep/signature", 1000, [&](unsigned i)
+        {
+          return offspring[i].signature();
+        },
+        [&]
+        {
+          offspring.clear();
+          for (std::size_t i(0); i < pool.size(); ++i)
+            offspring.push_back(crossover(pool[i],
+                                          pool[(i + 1) % pool.size()]));
+        });
+
+  // -------------------------------------------------------------------------
+  // Fitness cache.
+  // -------------------------------------------------------------------------
+  std::vector<hash_t> signatures;
+  for (const auto &prg : pool)
+    signatures.push_back(prg.signature());
+
+  cache tt(16);
+  b.run("cache/insert", 1000, [&](unsigned i)
+        {
+          return tt.insert(signatures[i], {static_cast<double>(i)});
+        });
+
+  b.run("cache/find", 1000, [&](unsigned i)
+        {
+          return tt.find(signatures[i]);
+        });
+
+  std::string image;
+  b.run("cache/save", 1, [&](unsigned)
+        {
+          std::ostringstream ss;
+          tt.save(ss);
+          image = ss.str();
+          return image.size();
+        });
+
+  b.run("cache/load", 1, [&](unsigned)
+        {
+          std::istringstream ss(image);
+          return tt.load(ss);
+        });
+
+  // -------------------------------------------------------------------------
+  // Interpreter.
+  // -------------------------------------------------------------------------
+  const auto &examples(reg.data());
+  b.run("interpreter/example", 100 * examples.size(), [&](unsigned i)
+        {
+          const auto &e(*std::next(examples.begin(),
+                                   i % examples.size()));
+          return src_interpreter<i_mep>(&pool[i / examples.size()])
+                 .run(e.input);
+        });
+
+  // -------------------------------------------------------------------------
+  // Evaluators.
+  // -------------------------------------------------------------------------
+  bench_evaluator<mae_evaluator<i_mep>>(b, "mae", reg, 100);
+  bench_evaluator<rmae_evaluator<i_mep>>(b, "rmae", reg, 100);
+  bench_evaluator<mse_evaluator<i_mep>>(b, "mse", reg, 100);
+  bench_evaluator<count_evaluator<i_mep>>(b, "count", reg, 100);
+  bench_evaluator<dyn_slot_evaluator<i_mep>>(b, "dyn_slot", cla, 100);
+  bench_evaluator<gaussian_evaluator<i_mep>>(b, "gaussian", cla, 100);
+  bench_evaluator<binary_evaluator<i_mep>>(b, "binary", cla, 100);
+
+  // -------------------------------------------------------------------------
+  // Output.
+  // -------------------------------------------------------------------------
+  if (!json.empty())
+  {
+    std::ofstream f(json);
+    b.write_json(f);
+  }
+
+  unsigned regressions(0);
+  if (!baseline.empty())
+  {
+    std::ifstream f(baseline);
+    if (!f)
+    {
+      std::cerr << "Cannot read baseline " << baseline << '\n';
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "\nComparison with " << baseline << ":\n";
+    regressions = b.compare(benchmark::read_baseline(f), tolerance,
+                            std::cout);
+  }
+
+  return static_cast<int>(regressions);
+}
@@ -0,0 +1,116 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstdlib>
+#include <random>
+
+#include "kernel/random.h"
+#include "utility/timer.h"
+
+int main()
+{
+  using namespace vita;
+
+  volatile std::uint64_t out(0);
+  const unsigned sup(200000000);
+
+  // -------------------------------------------------------------------------
+  // Bounded integers.
+  // -------------------------------------------------------------------------
+  timer t;
+  for (unsigned i(0); i < sup; ++i)
+  {
+    std::uniform_int_distribution<unsigned> d(0, i % 1000);
+    out = d(random::engine);
+  }
+
+  std::cout << "UNIFORM_INT_DISTRIBUTION - Elapsed: " << t.elapsed().count()
+            << "ms\n";
+
+  t.restart();
+  for (unsigned i(0); i < sup; ++i)
+    out = random::between(0u, i % 1000 + 1);
+
+  std::cout << "BETWEEN (LEMIRE)         - Elapsed: " << t.elapsed().count()
+            << "ms\n";
+
+  // -------------------------------------------------------------------------
+  // Bernoulli.
+  // -------------------------------------------------------------------------
+  t.restart();
+  for (unsigned i(0); i < sup; ++i)
+  {
+    std::bernoulli_distribution d(0.3);
+    out = d(random::engine);
+  }
+
+  std::cout << "BERNOULLI_DISTRIBUTION   - Elapsed: " << t.elapsed().count()
+            << "ms\n";
+
+  t.restart();
+  for (unsigned i(0); i < sup; ++i)
+    out = random::boolean(0.3);
+
+  std::cout << "BOOLEAN (THRESHOLD)      - Elapsed: " << t.elapsed().count()
+            << "ms\n";
+
+  // -------------------------------------------------------------------------
+  // Bulk generation.
+  // -------------------------------------------------------------------------
+  std::vector<std::uint64_t> buffer(1024);
+
+  t.restart();
+  for (unsigned i(0); i < sup / buffer.size(); ++i)
+  {
+    for (auto &v : buffer)
+      v = random::engine();
+    out = buffer.back();
+  }
+
+  std::cout << "ENGINE LOOP              - Elapsed: " << t.elapsed().count()
+            << "ms\n";
+
+  t.restart();
+  for (unsigned i(0); i < sup / buffer.size(); ++i)
+  {
+    random::engine.fill(buffer.begin(), buffer.end());
+    out = buffer.back();
+  }
+
+  std::cout << "ENGINE FILL              - Elapsed: " << t.elapsed().count()
+            << "ms\n";
+
+  std::vector<unsigned> values(1024);
+
+  t.restart();
+  for (unsigned i(0); i < sup / values.size(); ++i)
+  {
+    for (auto &v : values)
+      v = random::between(0u, 1000u);
+    out = values.back();
+  }
+
+  std::cout << "BETWEEN LOOP             - Elapsed: " << t.elapsed().count()
+            << "ms\n";
+
+  t.restart();
+  for (unsigned i(0); i < sup / values.size(); ++i)
+  {
+    random::fill(values.begin(), values.end(), 0u, 1000u);
+    out = values.back();
+  }
+
+  std::cout << "RANDOM FILL              - Elapsed: " << t.elapsed().count()
+            << "ms\n";
+
+  return !out;  // just to stop some warnings
+}
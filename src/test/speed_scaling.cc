@@ -0,0 +1,266 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include "kernel/vita.h"
+
+#include "test/benchmark.h"
+
+namespace
+{
+
+std::vector<unsigned> parse_list(const std::string &s)
+{
+  std::vector<unsigned> ret;
+
+  std::istringstream ss(s);
+  for (std::string item; std::getline(ss, item, ',');)
+    ret.push_back(static_cast<unsigned>(std::stoul(item)));
+
+  return ret;
+}
+
+// Peak resident set size (high water mark) of the process in KiB.
+// Only available on Linux (`0` elsewhere).
+std::uintmax_t peak_rss()
+{
+  std::ifstream status("/proc/self/status");
+
+  for (std::string line; std::getline(status, line);)
+    if (line.rfind("VmHWM:", 0) == 0)
+      return std::stoull(line.substr(6));
+
+  return 0;
+}
+
+// Resets the high water mark to the current RSS (Linux only, silently
+// ignored elsewhere) so that every point of the grid is measured on its own.
+void reset_peak_rss()
+{
+  std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+struct point
+{
+  bool classification;
+  unsigned rows, width, individuals, threads;
+
+  double seconds;
+  std::uintmax_t requests;     // fitness requests (cached or not)
+  std::uintmax_t evaluations;  // requests reaching the real evaluator
+  std::uintmax_t probes, hits;
+  std::uintmax_t rss_kib;
+};
+
+// Runs `p.threads` independent searches concurrently on the same kind of
+// task. Every search has its own problem, population and cache and uses its
+// own random substream: the result is reproducible and measures throughput
+// when the hardware is saturated with independent runs.
+void run(point &p, unsigned generations, unsigned seed)
+{
+  using namespace vita;
+
+  random::seed(seed);
+  const auto csv(synthetic_csv(p.rows, p.width, p.classification));
+
+  reset_peak_rss();
+
+  // Problems and searches are built by the main thread: symbols get their
+  // opcodes from a shared counter.
+  std::vector<std::unique_ptr<src_problem>> problems;
+  std::vector<std::unique_ptr<src_search<>>> searches;
+  for (unsigned t(0); t < p.threads; ++t)
+  {
+    auto prob(std::make_unique<src_problem>());
+
+    std::istringstream ss(csv);
+    prob->data().read_csv(ss);
+    prob->setup_symbols();
+    prob->env.individuals = p.individuals;
+    prob->env.generations = generations;
+
+    searches.push_back(std::make_unique<src_search<>>(*prob));
+    problems.push_back(std::move(prob));
+  }
+
+  std::vector<summary<i_mep>> results(p.threads);
+
+  const auto start(std::chrono::steady_clock::now());
+
+  std::vector<std::thread> workers;
+  for (unsigned t(0); t < p.threads; ++t)
+    workers.emplace_back([&, t]
+                         {
+                           random::seed(seed, t);
+                           results[t] = searches[t]->run();
+                         });
+  for (auto &w : workers)
+    w.join();
+
+  const std::chrono::duration<double> elapsed(
+    std::chrono::steady_clock::now() - start);
+
+  p.seconds = elapsed.count();
+  p.requests = p.evaluations = p.probes = p.hits = 0;
+  for (const auto &r : results)
+  {
+    p.requests += r.perf.requests;
+    p.evaluations += r.perf.evaluations;
+    p.probes += r.perf.cache_probes;
+    p.hits += r.perf.cache_hits;
+  }
+  p.rss_kib = peak_rss();
+}
+
+double hit_rate(const point &p)
+{
+  return p.probes ? static_cast<double>(p.hits) / p.probes : 0.0;
+}
+
+void usage()
+{
+  std::cout <<
+    "End-to-end scaling benchmark for src_search.\n\n"
+    "Usage:\n"
+    "  speed_scaling [options]\n\n"
+    "Options:\n"
+    "  --task T           regression, classification or both [default: both]\n"
+    "  --rows LIST        dataset sizes [default: 100,1000]\n"
+    "  --width LIST       number of input variables [default: 4]\n"
+    "  --individuals LIST population sizes [default: 100,500]\n"
+    "  --threads LIST     concurrent searches [default: 1,2]\n"
+    "  --generations N    generations per run [default: 10]\n"
+    "  --seed N           master seed [default: 20200101]\n"
+    "  --json FILE        writes the results in JSON format\n\n"
+    "LIST is a comma separated list of values: every combination is run.\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  using namespace vita;
+
+  std::string task("both"), json;
+  std::vector<unsigned> rows{100, 1000}, width{4}, individuals{100, 500},
+                        threads{1, 2};
+  unsigned generations(10), seed(20200101);
+
+  for (int i(1); i < argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    if (i + 1 == argc)
+    {
+      usage();
+      return EXIT_FAILURE;
+    }
+    const std::string value(argv[++i]);
+
+    if (arg == "--task")
+      task = value;
+    else if (arg == "--rows")
+      rows = parse_list(value);
+    else if (arg == "--width")
+      width = parse_list(value);
+    else if (arg == "--individuals")
+      individuals = parse_list(value);
+    else if (arg == "--threads")
+      threads = parse_list(value);
+    else if (arg == "--generations")
+      generations = static_cast<unsigned>(std::stoul(value));
+    else if (arg == "--seed")
+      seed = static_cast<unsigned>(std::stoul(value));
+    else if (arg == "--json")
+      json = value;
+    else
+    {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  log::reporting_level = log::lWARNING;
+
+  std::vector<bool> tasks;
+  if (task != "classification")
+    tasks.push_back(false);
+  if (task != "regression")
+    tasks.push_back(true);
+
+  std::cout << "task            rows width   pop thr       req/s      eval/s"
+               "    wall s  peak MiB  hit rate\n";
+
+  std::vector<point> points;
+  for (const bool cla : tasks)
+    for (const auto r : rows)
+      for (const auto w : width)
+        for (const auto ind : individuals)
+          for (const auto thr : threads)
+          {
+            point p{cla, r, w, ind, thr, 0.0, 0, 0, 0, 0, 0};
+            run(p, generations, seed);
+
+            std::cout << std::left << std::setw(14)
+                      << (cla ? "classification" : "regression")
+                      << std::right << std::setw(6) << r << std::setw(6) << w
+                      << std::setw(6) << ind << std::setw(4) << thr
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(12) << p.requests / p.seconds
+                      << std::setw(12) << p.evaluations / p.seconds
+                      << std::setprecision(3) << std::setw(10) << p.seconds
+                      << std::setprecision(1) << std::setw(10)
+                      << p.rss_kib / 1024.0
+                      << std::setprecision(3) << std::setw(10) << hit_rate(p)
+                      << std::endl;
+
+            points.push_back(p);
+          }
+
+  if (!json.empty())
+  {
+    std::ofstream f(json);
+
+    f << "{\n  \"generations\": " << generations << ",\n  \"seed\": " << seed
+      << ",\n  \"points\": [\n" << std::fixed;
+
+    for (std::size_t i(0); i < points.size(); ++i)
+    {
+      const auto &p(points[i]);
+
+      f << std::setprecision(3)
+        << "    {\"task\":\""
+        << (p.classification ? "classification" : "regression") << '"'
+        << ",\"rows\":" << p.rows << ",\"width\":" << p.width
+        << ",\"individuals\":" << p.individuals
+        << ",\"threads\":" << p.threads
+        << ",\"requests\":" << p.requests
+        << ",\"requests_per_second\":" << p.requests / p.seconds
+        << ",\"evaluations\":" << p.evaluations
+        << ",\"evaluations_per_second\":" << p.evaluations / p.seconds
+        << ",\"wall_seconds\":" << p.seconds
+        << ",\"peak_rss_kib\":" << p.rss_kib
+        << ",\"cache_probes\":" << p.probes
+        << ",\"cache_hits\":" << p.hits
+        << ",\"cache_hit_rate\":" << hit_rate(p) << '}'
+        << (i + 1 < points.size() ? ",\n" : "\n");
+    }
+
+    f << "  ]\n}\n";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -13,6 +13,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <map>
+#include <sstream>
 
 #include "kernel/i_mep.h"
 #include "kernel/random.h"
@@ -223,4 +224,60 @@ TEST_CASE("Distribution")
     }
 }
 
+TEST_CASE("Wide terminal set")
+{
+  vita::problem prob;
+  vita::symbol_factory factory;
+
+  prob.sset.insert(factory.make("FADD", {0}));
+
+  // Many terminals with different weights (as with a dataset having many
+  // columns).
+  std::map<const vita::symbol *, double> wanted;
+  double sum(0.0);
+  for (unsigned i(0); i < 300; ++i)
+  {
+    const double w(1 + i % 7);
+    wanted[prob.sset.insert(factory.make("REAL", {0}), w)] = w;
+    sum += w;
+  }
+
+  const unsigned n(3000000);
+  std::map<const vita::symbol *, double> hist;
+  for (unsigned i(0); i < n; ++i)
+    ++hist[&prob.sset.roulette_terminal(0)];
+
+  CHECK(hist.size() == wanted.size());
+  for (const auto &[s, w] : wanted)
+    CHECK(hist[s] / n == doctest::Approx(w / sum).epsilon(0.1));
+}
+
+TEST_CASE("Serialization")
+{
+  vita::problem prob;
+  vita::symbol_factory factory;
+
+  auto *fadd = prob.sset.insert(factory.make("FADD", {0}), 2.0);
+  auto *real = prob.sset.insert(factory.make("REAL", {0}));
+  auto *sife = prob.sset.insert(factory.make("SIFE", {1, 0}), 3.0);
+  auto *apple = prob.sset.insert(factory.make("apple", {1}));
+
+  std::stringstream ss;
+  CHECK(prob.sset.save(ss));
+
+  CHECK(prob.sset.load(ss));
+  CHECK(prob.sset.debug());
+  CHECK(prob.sset.weight(*fadd) == 2 * prob.sset.weight(*real));
+  CHECK(prob.sset.weight(*sife) == 3 * prob.sset.weight(*apple));
+
+  // Weights cannot be loaded in a symbol set with different symbols.
+  vita::problem prob2;
+  prob2.sset.insert(factory.make("FADD", {0}));
+  prob2.sset.insert(factory.make("REAL", {0}));
+
+  ss.clear();
+  ss.seekg(0);
+  CHECK(!prob2.sset.load(ss));
+}
+
 }  // TEST_SUITE("SYMBOL_SET")
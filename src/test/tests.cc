@@ -11,9 +11,12 @@
  */
 
 #include "test/cache.cc"
+#include "test/checkpoint.cc"
 #include "test/dataframe.cc"
 #include "test/de.cc"
 #include "test/discretization.cc"
+#include "test/distribution.cc"
+#include "test/evaluator.cc"
 #include "test/evolution.cc"
 #include "test/evolution_selection.cc"
 #include "test/facultative.cc"
@@ -25,10 +28,13 @@
 #include "test/i_mep.cc"
 #include "test/lambda.cc"
 #include "test/matrix.cc"
+#include "test/migration.cc"
+#include "test/pool_allocator.cc"
 #include "test/population.cc"
 #include "test/population_coord.cc"
 #include "test/primitive_d.cc"
 #include "test/primitive_i.cc"
+#include "test/random.cc"
 #include "test/small_vector.cc"
 #include "test/src_constant.cc"
 #include "test/src_problem.cc"
@@ -36,3 +42,4 @@
 #include "test/symbol_set.cc"
 #include "test/team.cc"
 #include "test/terminal.cc"
+#include "test/trace.cc"
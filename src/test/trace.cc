@@ -0,0 +1,107 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "kernel/src/search.h"
+#include "utility/trace.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+TEST_SUITE("TRACE")
+{
+
+TEST_CASE("Chrome trace format")
+{
+  using namespace vita;
+
+  trace::clear();
+
+  {
+    const trace::scope outer("outer");
+    {
+      const trace::scope inner("inner");
+    }
+
+    std::thread worker([] { const trace::scope s("worker"); });
+    worker.join();
+  }
+
+  std::stringstream ss;
+  CHECK(trace::write(ss));
+  const auto json(ss.str());
+
+  CHECK(json.find("\"traceEvents\"") != std::string::npos);
+  CHECK(json.find("\"name\":\"outer\"") != std::string::npos);
+  CHECK(json.find("\"name\":\"inner\"") != std::string::npos);
+  CHECK(json.find("\"name\":\"worker\"") != std::string::npos);
+  CHECK(json.find("\"ph\":\"X\"") != std::string::npos);
+
+  // Events of different threads have different ids.
+  const auto tid([&](const std::string &name)
+  {
+    const auto p(json.find("\"tid\":", json.find("\"name\":\"" + name)));
+    REQUIRE(p != std::string::npos);
+    return std::stoul(json.substr(p + 6));
+  });
+
+  CHECK(tid("outer") == tid("inner"));
+  CHECK(tid("outer") != tid("worker"));
+
+  trace::clear();
+  std::stringstream empty;
+  CHECK(trace::write(empty));
+  CHECK(empty.str().find("outer") == std::string::npos);
+}
+
+TEST_CASE("Search trace file")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lWARNING;
+
+  const auto path(std::filesystem::temp_directory_path()
+                  / "vita_search_trace.json");
+  std::filesystem::remove(path);
+
+  src_problem prob("./test_resources/mep.csv", src_problem::default_symbols);
+  REQUIRE(!!prob);
+
+  prob.env.individuals = 30;
+  prob.env.generations = 5;
+  prob.env.stat.trace_file = path.string();
+
+  trace::clear();
+  src_search<> s(prob);
+  s.run();
+
+#if defined(VITA_TRACE)
+  std::ifstream in(path);
+  REQUIRE(in);
+
+  const std::string json(std::istreambuf_iterator<char>(in), {});
+  CHECK(json.find("\"traceEvents\"") != std::string::npos);
+  CHECK(json.find("\"name\":\"generation\"") != std::string::npos);
+  CHECK(json.find("\"name\":\"evaluation\"") != std::string::npos);
+
+  std::filesystem::remove(path);
+#else
+  // Tracing is compiled out: there is nothing to save.
+  CHECK(!std::filesystem::exists(path));
+#endif
+}
+
+}  // TEST_SUITE("TRACE")
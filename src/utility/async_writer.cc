@@ -0,0 +1,125 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include "utility/async_writer.h"
+#include "utility/contracts.h"
+
+namespace vita
+{
+
+///
+/// \param[in] capacity maximum number of pending blocks
+///
+async_writer::async_writer(std::size_t capacity) : capacity_(capacity)
+{
+  Expects(capacity);
+}
+
+///
+/// Writes the pending data, closes the files and stops the worker thread.
+///
+async_writer::~async_writer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  not_empty_.notify_one();
+
+  if (worker_.joinable())
+    worker_.join();
+}
+
+///
+/// Queues a block of data to be appended to a file.
+///
+/// \param[in] path name of the file
+/// \param[in] data data to be appended
+///
+/// Blocks are written in the order they're queued. If the queue is full the
+/// call waits for the worker thread to make room.
+///
+void async_writer::write(const std::string &path, std::string data)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (!worker_.joinable())
+    worker_ = std::thread(&async_writer::loop, this);
+
+  not_full_.wait(lock, [this] { return queue_.size() < capacity_; });
+  queue_.push_back({path, std::move(data)});
+
+  lock.unlock();
+  not_empty_.notify_one();
+}
+
+///
+/// Waits until every queued block has been written and closes the files.
+///
+/// After the call the files are complete and can be read / modified by
+/// other means. They'll be reopened by the next `write()`.
+///
+void async_writer::flush()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return queue_.empty() && !busy_; });
+
+  // The worker is waiting for new data and cannot touch `files_`.
+  files_.clear();
+}
+
+///
+/// Body of the worker thread.
+///
+void async_writer::loop()
+{
+  for (;;)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+
+    if (queue_.empty())  // `stop_` and nothing left to write
+    {
+      files_.clear();
+      return;
+    }
+
+    auto r(std::move(queue_.front()));
+    queue_.pop_front();
+    busy_ = true;
+    lock.unlock();
+    not_full_.notify_one();
+
+    auto f(files_.find(r.path));
+    if (f == files_.end())
+      f = files_.emplace(r.path,
+                         std::ofstream(r.path, std::ios_base::app
+                                               | std::ios_base::binary))
+          .first;
+
+    f->second.write(r.data.data(), r.data.size());
+
+    lock.lock();
+    busy_ = false;
+    if (queue_.empty())
+    {
+      // Keep the files consistent when the producer is waiting.
+      for (auto &ff : files_)
+        ff.second.flush();
+
+      lock.unlock();
+      idle_.notify_all();
+    }
+  }
+}
+
+}  // namespace vita
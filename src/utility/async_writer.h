@@ -0,0 +1,77 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_ASYNC_WRITER_H)
+#define      VITA_ASYNC_WRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace vita
+{
+///
+/// Appends data to files from a background thread.
+///
+/// The producer (e.g. the evolution thread) prepares a block of data and
+/// hands it over via `write()`; opening the file, writing and flushing take
+/// place on a separate thread. Files are opened (in append mode) the first
+/// time they're referenced and kept open until `flush()`.
+///
+/// The queue is bounded: when it's full `write()` blocks, so a slow disk
+/// cannot make memory usage grow without limits.
+///
+/// The worker thread is started lazily: an unused writer doesn't cost a
+/// thread.
+///
+class async_writer
+{
+public:
+  explicit async_writer(std::size_t = 256);
+  ~async_writer();
+
+  async_writer(const async_writer &) = delete;
+  async_writer &operator=(const async_writer &) = delete;
+
+  void write(const std::string &, std::string);
+  void flush();
+
+private:
+  void loop();
+
+  struct record
+  {
+    std::string path;
+    std::string data;
+  };
+
+  std::deque<record> queue_;
+  const std::size_t capacity_;
+
+  // Accessed only by the worker thread (or when the worker is idle).
+  std::map<std::string, std::ofstream> files_;
+
+  std::mutex mutex_;
+  std::condition_variable not_empty_, not_full_, idle_;
+  bool busy_ = false;
+  bool stop_ = false;
+
+  std::thread worker_;
+};
+
+}  // namespace vita
+
+#endif  // include guard
@@ -0,0 +1,122 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_COW_MATRIX_H)
+#define      VITA_COW_MATRIX_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kernel/locus.h"
+#include "utility/contracts.h"
+#include "utility/pool_allocator.h"
+
+namespace vita
+{
+///
+/// A bidimensional matrix whose rows are grouped in reference-counted,
+/// copy-on-write chunks.
+///
+/// Copying a `cow_matrix` only copies a vector of pointers: the chunks are
+/// shared with the original and a chunk is duplicated the first time it's
+/// modified through a non-const accessor.
+///
+/// This is the storage for the genome of `i_mep` individuals: offspring
+/// produced by crossover / mutation usually differ from their parents in a
+/// small number of rows so most of the memory is shared.
+///
+/// Chunks are allocated via `pool_allocator`: genomes of the same population
+/// have the same size so blocks released by dead individuals are recycled by
+/// the new ones without involving the global allocator.
+///
+/// The shape can be fixed at compile time (`R` rows and / or `C` columns,
+/// `0` means *decided at run time*). With a fixed number of columns chunks
+/// are `std::array`s allocated together with their reference counter; with a
+/// fixed number of rows the chunk table is a `std::array` too and copying the
+/// matrix doesn't allocate anything. A fixed-shape matrix can still be empty
+/// (`rows() == cols() == 0`).
+///
+/// \warning
+/// Non-const accessors detach (i.e. privately copy) the involved chunk. Read
+/// only access should go through a const object (see `std::as_const`).
+///
+template<class T, std::size_t R = 0, std::size_t C = 0>
+class cow_matrix
+{
+public:
+  // *** Type alias ***
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+
+  /// Number of rows stored in a single chunk.
+  static constexpr std::size_t chunk_rows = 16;
+
+  explicit cow_matrix() : cow_matrix(0, 0) {}
+  explicit cow_matrix(std::size_t, std::size_t);
+
+  const_reference operator()(const locus &) const;
+  reference operator()(const locus &);
+  const_reference operator()(std::size_t, std::size_t) const;
+  reference operator()(std::size_t, std::size_t);
+
+  void set(const locus &, const T &);
+  void assign_rows(const cow_matrix &, std::size_t, std::size_t);
+
+  bool operator==(const cow_matrix &) const;
+
+  bool empty() const;
+  std::size_t rows() const;
+  std::size_t cols() const;
+
+  std::size_t shared_chunks(const cow_matrix &) const;
+
+private:
+  static constexpr std::size_t fixed_chunks =
+    (R + chunk_rows - 1) / chunk_rows;
+
+  using chunk_t = std::conditional_t<C != 0,
+                                     std::array<T, chunk_rows * C>,
+                                     std::vector<T, pool_allocator<T>>>;
+  using chunk_ptr = std::shared_ptr<chunk_t>;
+  using chunks_t = std::conditional_t<
+    R != 0,
+    std::array<chunk_ptr, fixed_chunks>,
+    std::vector<chunk_ptr, pool_allocator<chunk_ptr>>>;
+
+  static chunk_ptr make_chunk(std::size_t);
+  static chunk_ptr make_chunk(const chunk_t &);
+
+  // *** Private support functions ***
+  std::size_t chunk(std::size_t) const;
+  std::size_t offset(std::size_t, std::size_t) const;
+  chunk_t &writable(std::size_t);
+
+  // *** Private data members ***
+  chunks_t chunks_;
+
+  std::size_t rows_;
+  std::size_t cols_;
+};
+
+template<class T, std::size_t R, std::size_t C>
+bool operator!=(const cow_matrix<T, R, C> &, const cow_matrix<T, R, C> &);
+
+#include "utility/cow_matrix.tcc"
+}  // namespace vita
+
+#endif  // include guard
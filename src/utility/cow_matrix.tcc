@@ -0,0 +1,314 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_COW_MATRIX_H)
+#  error "Don't include this file directly, include the specific .h instead"
+#endif
+
+#if !defined(VITA_COW_MATRIX_TCC)
+#define      VITA_COW_MATRIX_TCC
+
+///
+/// Standard `rs` x `cs` matrix.
+///
+/// \param[in] rs number of rows
+/// \param[in] cs number of columns
+///
+/// Every chunk is allocated here and it's initially owned only by `this`.
+///
+template<class T, std::size_t R, std::size_t C>
+cow_matrix<T, R, C>::cow_matrix(std::size_t rs, std::size_t cs)
+  : chunks_(), rows_(rs), cols_(cs)
+{
+  Expects((rs && cs) || (!rs && !cs));
+  Expects(!R || !rs || rs == R);
+  Expects(!C || !cs || cs == C);
+
+  if constexpr (R != 0)
+  {
+    if (rs)
+      for (std::size_t k(0); k < fixed_chunks; ++k)
+        chunks_[k] = make_chunk(std::min(chunk_rows, rs - k * chunk_rows)
+                                * cs);
+  }
+  else
+  {
+    chunks_.reserve((rs + chunk_rows - 1) / chunk_rows);
+    for (std::size_t r(0); r < rs; r += chunk_rows)
+      chunks_.push_back(make_chunk(std::min(chunk_rows, rs - r) * cs));
+  }
+}
+
+///
+/// \param[in] n number of elements
+/// \return      a new chunk with `n` default-initialized elements
+///
+/// Control block and elements are taken from the memory pool. Fixed size
+/// chunks always have room for `chunk_rows` rows.
+///
+template<class T, std::size_t R, std::size_t C>
+typename cow_matrix<T, R, C>::chunk_ptr cow_matrix<T, R, C>::make_chunk(
+  [[maybe_unused]] std::size_t n)
+{
+  if constexpr (C != 0)
+    return std::allocate_shared<chunk_t>(pool_allocator<chunk_t>());
+  else
+    return std::allocate_shared<chunk_t>(pool_allocator<chunk_t>(), n);
+}
+
+///
+/// \param[in] c a chunk
+/// \return      a new chunk, copy of `c`
+///
+template<class T, std::size_t R, std::size_t C>
+typename cow_matrix<T, R, C>::chunk_ptr cow_matrix<T, R, C>::make_chunk(
+  const chunk_t &c)
+{
+  return std::allocate_shared<chunk_t>(pool_allocator<chunk_t>(), c);
+}
+
+///
+/// \param[in] r row
+/// \return      index of the chunk containing row `r`
+///
+template<class T, std::size_t R, std::size_t C>
+std::size_t cow_matrix<T, R, C>::chunk(std::size_t r) const
+{
+  assert(r < rows());
+
+  return r / chunk_rows;
+}
+
+///
+/// \param[in] r row
+/// \param[in] c column
+/// \return      the index of element `(r, c)` inside its chunk
+///
+template<class T, std::size_t R, std::size_t C>
+std::size_t cow_matrix<T, R, C>::offset(std::size_t r, std::size_t c) const
+{
+  assert(c < cols());
+
+  return (r % chunk_rows) * (C ? C : cols()) + c;
+}
+
+///
+/// \param[in] k index of a chunk
+/// \return      a reference to the `k`-th chunk, privately owned by `this`
+///
+/// If the chunk is shared with other matrices, it's copied before returning.
+///
+template<class T, std::size_t R, std::size_t C>
+typename cow_matrix<T, R, C>::chunk_t &cow_matrix<T, R, C>::writable(
+  std::size_t k)
+{
+  auto &p(chunks_[k]);
+
+  if (p.use_count() > 1)
+    p = make_chunk(*p);
+
+  return *p;
+}
+
+///
+/// \param[in] l a locus of the genome
+/// \return      an element of the matrix
+///
+template<class T, std::size_t R, std::size_t C>
+typename cow_matrix<T, R, C>::const_reference cow_matrix<T, R, C>::operator()(
+  const locus &l) const
+{
+  return operator()(l.index, l.category);
+}
+
+///
+/// \param[in] l a locus of the genome
+/// \return      an element of the matrix
+///
+/// \remark The chunk containing `l` is detached.
+///
+template<class T, std::size_t R, std::size_t C>
+typename cow_matrix<T, R, C>::reference cow_matrix<T, R, C>::operator()(
+  const locus &l)
+{
+  return operator()(l.index, l.category);
+}
+
+///
+/// \param[in] r row
+/// \param[in] c column
+/// \return      an element of the matrix
+///
+template<class T, std::size_t R, std::size_t C>
+typename cow_matrix<T, R, C>::const_reference cow_matrix<T, R, C>::operator()(
+  std::size_t r, std::size_t c) const
+{
+  return (*chunks_[chunk(r)])[offset(r, c)];
+}
+
+///
+/// \param[in] r row
+/// \param[in] c column
+/// \return      an element of the matrix
+///
+/// \remark The chunk containing row `r` is detached.
+///
+template<class T, std::size_t R, std::size_t C>
+typename cow_matrix<T, R, C>::reference cow_matrix<T, R, C>::operator()(
+  std::size_t r, std::size_t c)
+{
+  return writable(chunk(r))[offset(r, c)];
+}
+
+///
+/// Changes an element of the matrix only if the new value is different.
+///
+/// \param[in] l a locus of the genome
+/// \param[in] v the new value
+///
+/// Unlike `operator()(l) = v`, a shared chunk isn't detached when the
+/// assignment wouldn't change it.
+///
+template<class T, std::size_t R, std::size_t C>
+void cow_matrix<T, R, C>::set(const locus &l, const T &v)
+{
+  if (std::as_const(*this)(l) != v)
+    operator()(l) = v;
+}
+
+///
+/// Copies a range of rows from another matrix.
+///
+/// \param[in] m     source matrix (same dimensions of `this`)
+/// \param[in] first first row to be copied
+/// \param[in] last  one past the last row to be copied
+///
+/// Chunks completely included in `[first, last[` are shared with `m`, the
+/// remaining rows are copied element by element.
+///
+template<class T, std::size_t R, std::size_t C>
+void cow_matrix<T, R, C>::assign_rows(const cow_matrix &m,
+                                      std::size_t first, std::size_t last)
+{
+  Expects(rows() == m.rows());
+  Expects(cols() == m.cols());
+  Expects(first <= last);
+  Expects(last <= rows());
+
+  std::size_t r(first);
+  while (r < last)
+  {
+    const auto k(chunk(r));
+    const auto k_first(k * chunk_rows);
+    const auto k_last(std::min(k_first + chunk_rows, rows()));
+
+    if (r == k_first && k_last <= last)
+    {
+      chunks_[k] = m.chunks_[k];
+      r = k_last;
+    }
+    else
+    {
+      const std::size_t cs(C ? C : cols());  // constant bound when fixed
+
+      for (const auto r_last(std::min(k_last, last)); r < r_last; ++r)
+        for (std::size_t c(0); c < cs; ++c)
+          if (std::as_const(*this)(r, c) != m(r, c))
+            operator()(r, c) = m(r, c);
+    }
+  }
+}
+
+///
+/// \return `true` if the matrix is empty (`cols() == 0`)
+///
+template<class T, std::size_t R, std::size_t C>
+bool cow_matrix<T, R, C>::empty() const
+{
+  return rows() == 0;
+}
+
+///
+/// \return number of rows of the matrix
+///
+template<class T, std::size_t R, std::size_t C>
+std::size_t cow_matrix<T, R, C>::rows() const
+{
+  return rows_;
+}
+
+///
+/// \return number of columns of the matrix
+///
+template<class T, std::size_t R, std::size_t C>
+std::size_t cow_matrix<T, R, C>::cols() const
+{
+  return cols_;
+}
+
+///
+/// \param[in] m second term of comparison
+/// \return      `true` if `m` is equal to `*this`
+///
+/// Shared chunks are equal by definition and aren't scanned.
+///
+template<class T, std::size_t R, std::size_t C>
+bool cow_matrix<T, R, C>::operator==(const cow_matrix &m) const
+{
+  if (rows() != m.rows() || cols() != m.cols())
+    return false;
+
+  for (std::size_t k(0); k < chunks_.size(); ++k)
+    if (chunks_[k] != m.chunks_[k])
+    {
+      // Fixed size chunks may contain unused elements.
+      const auto n(std::min(chunk_rows, rows() - k * chunk_rows) * cols());
+
+      if (!std::equal(chunks_[k]->begin(), std::next(chunks_[k]->begin(), n),
+                      m.chunks_[k]->begin()))
+        return false;
+    }
+
+  return true;
+}
+
+///
+/// \param[in] m another matrix
+/// \return      number of chunks shared by `this` and `m`
+///
+template<class T, std::size_t R, std::size_t C>
+std::size_t cow_matrix<T, R, C>::shared_chunks(const cow_matrix &m) const
+{
+  if (rows() != m.rows() || cols() != m.cols())
+    return 0;
+
+  std::size_t n(0);
+  for (std::size_t k(0); k < chunks_.size(); ++k)
+    if (chunks_[k] && chunks_[k] == m.chunks_[k])
+      ++n;
+
+  return n;
+}
+
+///
+/// \param[in] lhs first term of comparison
+/// \param[in] rhs second term of comparison
+/// \return        `true` if `lhs` is not equal to `rhs`
+///
+template<class T, std::size_t R, std::size_t C>
+bool operator!=(const cow_matrix<T, R, C> &lhs,
+                const cow_matrix<T, R, C> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+#endif  // include guard
@@ -0,0 +1,222 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_POOL_ALLOCATOR_H)
+#define      VITA_POOL_ALLOCATOR_H
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace vita
+{
+namespace detail
+{
+///
+/// Per-thread free lists of fixed-size memory blocks.
+///
+/// Blocks are grouped in size classes (multiples of `granularity` bytes up to
+/// `max_block`). A released block is kept in the free list of its class and
+/// reused by the next request of the same class: in the steady state of an
+/// evolution (same-sized genomes continuously created and destroyed) no call
+/// reaches the global allocator.
+///
+/// Every thread has its own pool so there isn't any locking. A block can be
+/// released by a thread different from the one that allocated it (it simply
+/// migrates to the pool of the releasing thread).
+///
+/// \remark
+/// Every free list keeps at most `max_cached` bytes: blocks exceeding the
+/// limit go back to the global allocator. This bounds the memory held by a
+/// thread that mostly releases blocks allocated elsewhere (e.g. the workers
+/// of an `evaluator_pool`) and the memory kept after a peak of allocations.
+///
+class block_pool
+{
+public:
+  static constexpr std::size_t granularity = 16;
+  static constexpr std::size_t max_block = 4096;
+  static constexpr std::size_t max_cached = 256 * 1024;
+
+  block_pool() = default;
+  block_pool(const block_pool &) = delete;
+  block_pool &operator=(const block_pool &) = delete;
+
+  ~block_pool()
+  {
+    for (auto &l : free_)
+      while (l.head)
+        ::operator delete(std::exchange(l.head, l.head->next));
+  }
+
+  /// \param[in] bytes size of the requested block
+  /// \return          a block of at least `bytes` bytes
+  void *allocate(std::size_t bytes)
+  {
+    if (bytes > max_block)
+      return ::operator new(bytes);
+
+    auto &l(free_[size_class(bytes)]);
+    if (l.head)
+    {
+      --l.size;
+      return std::exchange(l.head, l.head->next);
+    }
+
+    return allocate_global(bytes);
+  }
+
+  /// \param[in] bytes size of the requested block
+  /// \return          a block of at least `bytes` bytes taken from the global
+  ///                  allocator
+  ///
+  /// \remark
+  /// The block has the full size of its class: it can be released into any
+  /// pool (e.g. memory allocated when the pool of the thread is no longer
+  /// available).
+  static void *allocate_global(std::size_t bytes)
+  {
+    return ::operator new(bytes > max_block ? bytes
+                                            : size_class(bytes) * granularity);
+  }
+
+  /// \param[in] p     a block previously obtained via `allocate`
+  /// \param[in] bytes size of the block (the same passed to `allocate`)
+  void deallocate(void *p, std::size_t bytes) noexcept
+  {
+    if (bytes > max_block)
+    {
+      ::operator delete(p);
+      return;
+    }
+
+    const auto c(size_class(bytes));
+    auto &l(free_[c]);
+    if (l.size >= max_cached / (c * granularity))
+    {
+      ::operator delete(p);
+      return;
+    }
+
+    l.head = ::new (p) node{l.head};
+    ++l.size;
+  }
+
+  /// \param[in] bytes size of a block
+  /// \return          number of free blocks of the size class of `bytes`
+  std::size_t cached(std::size_t bytes) const noexcept
+  {
+    return bytes > max_block ? 0 : free_[size_class(bytes)].size;
+  }
+
+private:
+  struct node { node *next; };
+
+  struct free_list
+  {
+    node        *head = nullptr;
+    std::size_t  size = 0;
+  };
+
+  static constexpr std::size_t size_class(std::size_t bytes) noexcept
+  {
+    return bytes ? (bytes + granularity - 1) / granularity : 1;
+  }
+
+  std::array<free_list, max_block / granularity + 1> free_ {};
+};
+
+///
+/// \return the memory pool of the current thread (`nullptr` during / after
+///         its destruction)
+///
+/// \remark
+/// The pool is destroyed at thread exit. Memory released after that point
+/// goes straight back to the global allocator.
+///
+inline block_pool *local_pool() noexcept
+{
+  // `destroyed` is trivially destructible: it can be read safely from the
+  // destructors of other thread-local objects running after `h`'s one.
+  thread_local bool destroyed(false);
+
+  struct holder
+  {
+    ~holder() { destroyed = true; }
+
+    block_pool pool;
+  };
+
+  if (destroyed)
+    return nullptr;
+
+  thread_local holder h;
+  return &h.pool;
+}
+
+}  // namespace detail
+
+///
+/// A stateless STL allocator drawing memory from per-thread free lists.
+///
+/// \tparam T type of the allocated objects
+///
+/// Meant for the many small, same-sized, short-lived blocks of the genomes
+/// (see `cow_matrix`). All the instances are interchangeable.
+///
+template<class T>
+class pool_allocator
+{
+public:
+  using value_type = T;
+
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "Over-aligned types aren't supported");
+
+  pool_allocator() noexcept = default;
+  template<class U> pool_allocator(const pool_allocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n)
+  {
+    const auto bytes(n * sizeof(T));
+
+    if (auto *p = detail::local_pool())
+      return static_cast<T *>(p->allocate(bytes));
+
+    return static_cast<T *>(detail::block_pool::allocate_global(bytes));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept
+  {
+    if (auto *pool = detail::local_pool())
+      pool->deallocate(p, n * sizeof(T));
+    else
+      ::operator delete(p);
+  }
+};
+
+template<class T, class U>
+bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) noexcept
+{
+  return true;
+}
+
+template<class T, class U>
+bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) noexcept
+{
+  return false;
+}
+
+}  // namespace vita
+
+#endif  // include guard
@@ -0,0 +1,86 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_SPAN_H)
+#define      VITA_SPAN_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "utility/contracts.h"
+
+namespace vita
+{
+
+///
+/// A non-owning view over a contiguous sequence of objects.
+///
+/// \tparam T type of the elements (`const T` for a read-only view)
+///
+/// This is a small subset of C++20 `std::span` (dynamic extent only). It's
+/// used to access the content of an object (e.g. the genome of an individual)
+/// without copying it.
+///
+/// \warning
+/// The view doesn't extend the lifetime of the referenced sequence.
+///
+template<class T>
+class span
+{
+public:
+  // *** Type aliases *** (for playing nicely with STL)
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+
+  using iterator = T *;
+  using pointer = T *;
+  using reference = T &;
+
+  using size_type = std::size_t;
+
+  constexpr span() noexcept : data_(nullptr), size_(0) {}
+  constexpr span(pointer p, size_type n) noexcept : data_(p), size_(n) {}
+
+  template<class A>
+  span(const std::vector<value_type, A> &v) noexcept
+    : data_(v.data()), size_(v.size())
+  {
+    static_assert(std::is_const_v<T>,
+                  "Only read-only views can reference a const vector");
+  }
+
+  template<class A>
+  span(std::vector<value_type, A> &v) noexcept
+    : data_(v.data()), size_(v.size()) {}
+
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+  constexpr pointer data() const noexcept { return data_; }
+  constexpr size_type size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return !size_; }
+
+  reference operator[](size_type i) const
+  {
+    Expects(i < size_);
+    return data_[i];
+  }
+
+private:
+  pointer   data_;
+  size_type size_;
+};
+
+}  // namespace vita
+
+#endif  // include guard
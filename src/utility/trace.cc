@@ -0,0 +1,156 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "utility/trace.h"
+#include "utility/utility.h"
+
+namespace vita::trace
+{
+
+namespace
+{
+struct event
+{
+  const char *name;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::nanoseconds duration;
+};
+
+// Events of a single thread. The mutex is almost never contended: only
+// `write` / `clear` access the buffer from a different thread.
+struct thread_buffer
+{
+  explicit thread_buffer(unsigned i) : id(i) {}
+
+  std::mutex mutex;
+  std::vector<event> events;
+  const unsigned id;
+};
+
+struct registry
+{
+  std::mutex mutex;
+  std::vector<std::shared_ptr<thread_buffer>> buffers;
+  const std::chrono::steady_clock::time_point epoch =
+    std::chrono::steady_clock::now();
+};
+
+registry &global()
+{
+  static registry r;
+  return r;
+}
+
+// Buffers outlive their threads (they're shared with the registry) so events
+// of terminated threads are still available.
+thread_buffer &local()
+{
+  thread_local const std::shared_ptr<thread_buffer> b([]
+  {
+    auto &r(global());
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    r.buffers.push_back(std::make_shared<thread_buffer>(r.buffers.size()));
+    return r.buffers.back();
+  }());
+
+  return *b;
+}
+}  // namespace
+
+///
+/// Stores the event corresponding to the lifetime of the object.
+///
+scope::~scope()
+{
+  const auto end(std::chrono::steady_clock::now());
+
+  auto &b(local());
+  std::lock_guard<std::mutex> lock(b.mutex);
+  b.events.push_back({name_, start_, end - start_});
+}
+
+///
+/// Discards the events recorded so far.
+///
+void clear()
+{
+  auto &r(global());
+  std::lock_guard<std::mutex> lock(r.mutex);
+
+  for (auto &b : r.buffers)
+  {
+    std::lock_guard<std::mutex> lock_b(b->mutex);
+    b->events.clear();
+  }
+}
+
+///
+/// Writes the recorded events in the Chrome trace event format.
+///
+/// \param[out] out output stream
+/// \return         `true` on success
+///
+bool write(std::ostream &out)
+{
+  SAVE_FLAGS(out);
+
+  auto &r(global());
+  std::lock_guard<std::mutex> lock(r.mutex);
+
+  const auto us([](std::chrono::nanoseconds t)
+                {
+                  return std::chrono::duration<double, std::micro>(t).count();
+                });
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  bool first(true);
+  for (const auto &b : r.buffers)
+  {
+    std::lock_guard<std::mutex> lock_b(b->mutex);
+
+    for (const auto &e : b->events)
+    {
+      out << (first ? "\n" : ",\n")
+          << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1"
+          << ",\"tid\":" << b->id << std::fixed << std::setprecision(3)
+          << ",\"ts\":" << us(e.start - r.epoch)
+          << ",\"dur\":" << us(e.duration) << '}';
+      first = false;
+    }
+  }
+
+  out << "\n]}\n";
+  return out.good();
+}
+
+///
+/// Writes the recorded events to a file.
+///
+/// \param[in] path name of the output file
+/// \return         `true` on success
+///
+bool save(const std::string &path)
+{
+  std::ofstream out(path);
+  return out && write(out);
+}
+
+}  // namespace vita::trace
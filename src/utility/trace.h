@@ -0,0 +1,81 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2020 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_TRACE_H)
+#define      VITA_TRACE_H
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace vita
+{
+///
+/// Scoped event tracing in the Chrome trace event format.
+///
+/// Instrumented code marks regions with `VITA_TRACE_SCOPE("name")`. When the
+/// framework is compiled with `VITA_TRACE` defined (CMake option
+/// `-DVITA_TRACE=ON`), every region produces a *complete* event (begin
+/// timestamp, duration, thread) stored in a per-thread buffer. `trace::save()`
+/// writes all the events to a JSON file which can be opened with
+/// `chrome://tracing` or <https://ui.perfetto.dev> to see where, and on which
+/// thread, time goes. `search::run` calls it at the end of the search when
+/// `environment::stat::trace_file` is set.
+///
+/// Without `VITA_TRACE` the macro expands to nothing: there is no cost at
+/// all.
+///
+/// \warning
+/// Event names must be string literals (or otherwise have static storage
+/// duration): only the pointer is stored.
+///
+namespace trace
+{
+void clear();
+bool save(const std::string &);
+bool write(std::ostream &);
+
+///
+/// Records the lifetime of an object as a trace event.
+///
+class scope
+{
+public:
+  explicit scope(const char *name)
+    : name_(name), start_(std::chrono::steady_clock::now())
+  {
+  }
+
+  ~scope();
+
+  scope(const scope &) = delete;
+  scope &operator=(const scope &) = delete;
+
+private:
+  const char *name_;
+  std::chrono::steady_clock::time_point start_;
+};
+}  // namespace trace
+
+}  // namespace vita
+
+#define VITA_TRACE_CAT2(a, b) a ## b
+#define VITA_TRACE_CAT(a, b) VITA_TRACE_CAT2(a, b)
+
+#if defined(VITA_TRACE)
+#  define VITA_TRACE_SCOPE(name) \
+     const vita::trace::scope VITA_TRACE_CAT(vita_trace_scope_, __LINE__)(name)
+#else
+#  define VITA_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif  // include guard
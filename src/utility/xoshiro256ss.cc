@@ -56,6 +56,36 @@ void seed_with_sm64(std::uint64_t seed, T &state)
   std::generate(state.begin(), state.end(), [&sm]{ return sm.next(); });
 }
 
+///
+/// Advances the state of an engine by a fixed (huge) number of steps.
+///
+/// \param[in]     poly  the jump polynomial (it determines the length of the
+///                      jump)
+/// \param[in,out] state the state of the engine
+/// \param[in]     next  advances the engine by one step
+///
+/// The jump is performed multiplying the characteristic polynomial of the
+/// linear engine and has the same cost of `64 * state.size()` calls to the
+/// generator.
+///
+template<class T, class F>
+void jump_with(const T &poly, T &state, F next)
+{
+  T s{};
+
+  for (const auto p : poly)
+    for (unsigned b(0); b < 64; ++b)
+    {
+      if (p & std::uint64_t(1) << b)
+        for (std::size_t i(0); i < s.size(); ++i)
+          s[i] ^= state[i];
+
+      next();
+    }
+
+  state = s;
+}
+
 }  // unnamed namespace
 
 
@@ -79,6 +109,41 @@ void xoshiro256ss::seed(xoshiro256ss::result_type s) noexcept
   seed_with_sm64(s, state);
 }
 
+///
+/// Advances the engine by `2^128` steps.
+///
+/// It can be used to generate `2^128` non-overlapping subsequences for
+/// parallel computations.
+///
+void xoshiro256ss::jump() noexcept
+{
+  static constexpr decltype(state) poly =
+  {
+    0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+    0xa9582618e03fc9aa, 0x39abdc4529b1661c
+  };
+
+  jump_with(poly, state, [this]{ operator()(); });
+}
+
+///
+/// Advances the engine by `2^192` steps.
+///
+/// It can be used to generate `2^64` starting points, from each of which
+/// jump() will generate `2^64` non-overlapping subsequences for parallel
+/// distributed computations.
+///
+void xoshiro256ss::long_jump() noexcept
+{
+  static constexpr decltype(state) poly =
+  {
+    0x76e15d3efefdcbbf, 0xc5004e441c522fb3,
+    0x77710069854ee241, 0x39109bb02acbe635
+  };
+
+  jump_with(poly, state, [this]{ operator()(); });
+}
+
 ///
 /// Writes to the output stream the representation of the current state.
 ///
@@ -108,7 +173,7 @@ std::ostream &operator<<(std::ostream &o, const xoshiro256ss &e)
 ///
 std::istream &operator>>(std::istream &i, xoshiro256ss &e)
 {
-  return i >> e.state[0] >> e.state[1] >> e.state[2] >> e.state[31];
+  return i >> e.state[0] >> e.state[1] >> e.state[2] >> e.state[3];
 }
 
 ///
@@ -127,6 +192,39 @@ void xoroshiro128p::seed(xoroshiro128p::result_type s) noexcept
   seed_with_sm64(s, state);
 }
 
+///
+/// Advances the engine by `2^64` steps.
+///
+/// It can be used to generate `2^64` non-overlapping subsequences for
+/// parallel computations.
+///
+void xoroshiro128p::jump() noexcept
+{
+  static constexpr decltype(state) poly =
+  {
+    0xdf900294d8f554a5, 0x170865df4b3201fc
+  };
+
+  jump_with(poly, state, [this]{ operator()(); });
+}
+
+///
+/// Advances the engine by `2^96` steps.
+///
+/// It can be used to generate `2^32` starting points, from each of which
+/// jump() will generate `2^32` non-overlapping subsequences for parallel
+/// distributed computations.
+///
+void xoroshiro128p::long_jump() noexcept
+{
+  static constexpr decltype(state) poly =
+  {
+    0xd2a98b26625eee7b, 0xdddf9b1090aa7ac1
+  };
+
+  jump_with(poly, state, [this]{ operator()(); });
+}
+
 ///
 /// Writes to the output stream the representation of the current state.
 ///
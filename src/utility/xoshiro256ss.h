@@ -111,6 +111,24 @@ public:
   void seed() noexcept ;
   void seed(result_type) noexcept;
 
+  /// Fills a range with consecutive outputs of the engine.
+  ///
+  /// \param[out] first beginning of the range
+  /// \param[out] last  end of the range
+  ///
+  /// Same values of repeated calls to `operator()` but the state stays in
+  /// registers for the whole loop.
+  template<class It> void fill(It first, It last) noexcept
+  {
+    auto e(*this);
+    for (; first != last; ++first)
+      *first = e();
+    *this = e;
+  }
+
+  void jump() noexcept;
+  void long_jump() noexcept;
+
   bool operator==(const xoshiro256ss &rhs) const noexcept
   { return state == rhs.state; }
   bool operator!=(const xoshiro256ss &rhs) const noexcept
@@ -180,6 +198,24 @@ public:
   void seed() noexcept ;
   void seed(result_type) noexcept;
 
+  /// Fills a range with consecutive outputs of the engine.
+  ///
+  /// \param[out] first beginning of the range
+  /// \param[out] last  end of the range
+  ///
+  /// Same values of repeated calls to `operator()` but the state stays in
+  /// registers for the whole loop.
+  template<class It> void fill(It first, It last) noexcept
+  {
+    auto e(*this);
+    for (; first != last; ++first)
+      *first = e();
+    *this = e;
+  }
+
+  void jump() noexcept;
+  void long_jump() noexcept;
+
   bool operator==(const xoroshiro128p &rhs) const noexcept
   { return state == rhs.state; }
   bool operator!=(const xoroshiro128p &rhs) const noexcept